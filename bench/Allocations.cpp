@@ -0,0 +1,73 @@
+#include "Bench.h"
+
+#include <cstdlib>
+#include <new>
+
+// replaces the global allocation functions, so every program can count what the headers under test allocate
+// allocations made by tbb's own allocator, or by malloc directly, aren't seen
+
+namespace
+{
+	std::atomic_uint64_t processCount{ 0 };
+	std::atomic_uint64_t processBytes{ 0 };
+	thread_local bench::Allocations threadAllocations;
+
+	void Count(std::size_t a_size) noexcept
+	{
+		processCount.fetch_add(1, std::memory_order_relaxed);
+		processBytes.fetch_add(a_size, std::memory_order_relaxed);
+		++threadAllocations.count;
+		threadAllocations.bytes += a_size;
+	}
+
+	[[nodiscard]] void* Allocate(std::size_t a_size, std::size_t a_alignment = 0) noexcept
+	{
+		Count(a_size);
+		if (a_alignment > alignof(std::max_align_t)) {
+			return std::aligned_alloc(a_alignment, (std::max<std::size_t>(a_size, 1) + a_alignment - 1) & ~(a_alignment - 1));
+		} else {
+			return std::malloc(std::max<std::size_t>(a_size, 1));
+		}
+	}
+
+	[[nodiscard]] void* AllocateOrThrow(std::size_t a_size, std::size_t a_alignment = 0)
+	{
+		const auto result = Allocate(a_size, a_alignment);
+		if (!result) {
+			throw std::bad_alloc{};
+		}
+		return result;
+	}
+}
+
+namespace bench
+{
+	Allocations ProcessAllocations() noexcept
+	{
+		return { processCount.load(std::memory_order_relaxed), processBytes.load(std::memory_order_relaxed) };
+	}
+
+	Allocations ThreadAllocations() noexcept { return threadAllocations; }
+}
+
+void* operator new(std::size_t a_size) { return AllocateOrThrow(a_size); }
+void* operator new[](std::size_t a_size) { return AllocateOrThrow(a_size); }
+void* operator new(std::size_t a_size, std::align_val_t a_alignment) { return AllocateOrThrow(a_size, static_cast<std::size_t>(a_alignment)); }
+void* operator new[](std::size_t a_size, std::align_val_t a_alignment) { return AllocateOrThrow(a_size, static_cast<std::size_t>(a_alignment)); }
+void* operator new(std::size_t a_size, const std::nothrow_t&) noexcept { return Allocate(a_size); }
+void* operator new[](std::size_t a_size, const std::nothrow_t&) noexcept { return Allocate(a_size); }
+void* operator new(std::size_t a_size, std::align_val_t a_alignment, const std::nothrow_t&) noexcept { return Allocate(a_size, static_cast<std::size_t>(a_alignment)); }
+void* operator new[](std::size_t a_size, std::align_val_t a_alignment, const std::nothrow_t&) noexcept { return Allocate(a_size, static_cast<std::size_t>(a_alignment)); }
+
+void operator delete(void* a_ptr) noexcept { std::free(a_ptr); }
+void operator delete[](void* a_ptr) noexcept { std::free(a_ptr); }
+void operator delete(void* a_ptr, std::size_t) noexcept { std::free(a_ptr); }
+void operator delete[](void* a_ptr, std::size_t) noexcept { std::free(a_ptr); }
+void operator delete(void* a_ptr, std::align_val_t) noexcept { std::free(a_ptr); }
+void operator delete[](void* a_ptr, std::align_val_t) noexcept { std::free(a_ptr); }
+void operator delete(void* a_ptr, std::size_t, std::align_val_t) noexcept { std::free(a_ptr); }
+void operator delete[](void* a_ptr, std::size_t, std::align_val_t) noexcept { std::free(a_ptr); }
+void operator delete(void* a_ptr, const std::nothrow_t&) noexcept { std::free(a_ptr); }
+void operator delete[](void* a_ptr, const std::nothrow_t&) noexcept { std::free(a_ptr); }
+void operator delete(void* a_ptr, std::align_val_t, const std::nothrow_t&) noexcept { std::free(a_ptr); }
+void operator delete[](void* a_ptr, std::align_val_t, const std::nothrow_t&) noexcept { std::free(a_ptr); }
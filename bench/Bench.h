@@ -0,0 +1,218 @@
+#pragma once
+
+// scaffolding shared by the host-side tests and benchmarks
+// tests exit non-zero once any check fails, benchmarks print their tables and only fail on a broken invariant
+// every program accepts --quick, which shrinks the data and iteration counts to what ctest can run in seconds
+
+#include <malloc.h>
+#include <unistd.h>
+
+#include <source_location>
+
+namespace bench
+{
+	// allocations made through the global operator new, which Allocations.cpp replaces
+	struct Allocations
+	{
+	public:
+		[[nodiscard]] friend Allocations operator-(const Allocations& a_lhs, const Allocations& a_rhs) noexcept
+		{
+			return { a_lhs.count - a_rhs.count, a_lhs.bytes - a_rhs.bytes };
+		}
+
+		std::uint64_t count{ 0 };
+		std::uint64_t bytes{ 0 };
+	};
+
+	// across every thread
+	[[nodiscard]] Allocations ProcessAllocations() noexcept;
+
+	// on the calling thread only
+	[[nodiscard]] Allocations ThreadAllocations() noexcept;
+
+	[[nodiscard]] inline std::size_t ResidentBytes()
+	{
+		std::ifstream statm{ "/proc/self/statm" };
+		std::size_t pages = 0;
+		std::size_t resident = 0;
+		statm >> pages >> resident;
+		return resident * static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+	}
+
+	// bytes the allocator holds for live allocations, including its own bookkeeping and mmapped blocks
+	// unlike the resident set, freeing memory lowers it again, so consecutive measurements don't skew each other
+	[[nodiscard]] inline std::size_t HeapBytes() noexcept
+	{
+		const auto info = ::mallinfo2();
+		return info.uordblks + info.hblkhd;
+	}
+
+	[[nodiscard]] inline bool Quick(int a_argc, char* a_argv[]) noexcept
+	{
+		return std::any_of(a_argv + 1, a_argv + a_argc, [](const char* a_arg) noexcept {
+			return a_arg == "--quick"sv;
+		});
+	}
+
+	using clock_type = std::chrono::steady_clock;
+
+	[[nodiscard]] inline std::chrono::nanoseconds Elapsed(clock_type::time_point a_start) noexcept
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - a_start);
+	}
+
+	// latency samples, summarized once every run is in
+	class Samples
+	{
+	public:
+		template <class F>
+		[[nodiscard]] static Samples Measure(std::size_t a_iterations, F&& a_func)
+		{
+			Samples samples;
+			samples._values.reserve(a_iterations);
+			for (std::size_t i = 0; i < a_iterations; ++i) {
+				const auto start = clock_type::now();
+				a_func();
+				samples.push_back(Elapsed(start));
+			}
+			return samples;
+		}
+
+		void push_back(std::chrono::nanoseconds a_value)
+		{
+			_values.push_back(static_cast<double>(a_value.count()));
+			_sorted = false;
+		}
+
+		[[nodiscard]] bool empty() const noexcept { return _values.empty(); }
+		[[nodiscard]] std::size_t size() const noexcept { return _values.size(); }
+
+		[[nodiscard]] double percentile(double a_pct) const
+		{
+			if (_values.empty()) {
+				return 0.0;
+			}
+
+			sort();
+			const auto rank = a_pct / 100.0 * static_cast<double>(_values.size() - 1);
+			return _values[static_cast<std::size_t>(rank + 0.5)];
+		}
+
+		[[nodiscard]] double median() const { return percentile(50.0); }
+		[[nodiscard]] double p99() const { return percentile(99.0); }
+
+		[[nodiscard]] double mean() const noexcept
+		{
+			return _values.empty() ? 0.0 : std::accumulate(_values.begin(), _values.end(), 0.0) / static_cast<double>(_values.size());
+		}
+
+	private:
+		void sort() const
+		{
+			if (!_sorted) {
+				std::sort(_values.begin(), _values.end());
+				_sorted = true;
+			}
+		}
+
+		mutable std::vector<double> _values;  // nanoseconds
+		mutable bool _sorted{ true };
+	};
+
+	[[nodiscard]] inline std::string FormatDuration(double a_nanoseconds)
+	{
+		return a_nanoseconds < 1e3 ? fmt::format(FMT_STRING("{:.0f} ns"), a_nanoseconds) :
+		       a_nanoseconds < 1e6 ? fmt::format(FMT_STRING("{:.1f} us"), a_nanoseconds / 1e3) :
+		       a_nanoseconds < 1e9 ? fmt::format(FMT_STRING("{:.2f} ms"), a_nanoseconds / 1e6) :
+		                             fmt::format(FMT_STRING("{:.2f} s"), a_nanoseconds / 1e9);
+	}
+
+	[[nodiscard]] inline std::string FormatBytes(double a_bytes)
+	{
+		return a_bytes < 0x400    ? fmt::format(FMT_STRING("{:.0f} B"), a_bytes) :
+		       a_bytes < 0x100000 ? fmt::format(FMT_STRING("{:.1f} KiB"), a_bytes / 0x400) :
+		                            fmt::format(FMT_STRING("{:.1f} MiB"), a_bytes / 0x100000);
+	}
+
+	[[nodiscard]] inline std::string FormatRate(double a_perSecond, std::string_view a_unit)
+	{
+		return a_perSecond < 1e3 ? fmt::format(FMT_STRING("{:.1f} {}/s"), a_perSecond, a_unit) :
+		       a_perSecond < 1e6 ? fmt::format(FMT_STRING("{:.1f} K{}/s"), a_perSecond / 1e3, a_unit) :
+		                           fmt::format(FMT_STRING("{:.1f} M{}/s"), a_perSecond / 1e6, a_unit);
+	}
+
+	// rows are printed once the table is complete, with every column sized to fit
+	class Table
+	{
+	public:
+		explicit Table(std::vector<std::string> a_header) :
+			_header(std::move(a_header))
+		{}
+
+		void add(std::vector<std::string> a_row)
+		{
+			a_row.resize(_header.size());
+			_rows.push_back(std::move(a_row));
+		}
+
+		void print(std::string_view a_title) const
+		{
+			std::vector<std::size_t> widths(_header.size());
+			const auto fit = [&](const std::vector<std::string>& a_row) {
+				for (std::size_t i = 0; i < a_row.size(); ++i) {
+					widths[i] = std::max(widths[i], a_row[i].length());
+				}
+			};
+			fit(_header);
+			std::for_each(_rows.begin(), _rows.end(), fit);
+
+			const auto line = [&](const std::vector<std::string>& a_row) {
+				std::string buf;
+				for (std::size_t i = 0; i < a_row.size(); ++i) {
+					// the first column is a label, the rest are numbers
+					buf += i == 0 ?
+                               fmt::format(FMT_STRING("{:<{}}"), a_row[i], widths[i]) :
+                               fmt::format(FMT_STRING("  {:>{}}"), a_row[i], widths[i]);
+				}
+				fmt::print(FMT_STRING("{}\n"), buf);
+			};
+
+			fmt::print(FMT_STRING("\n== {} ==\n"), a_title);
+			line(_header);
+			std::for_each(_rows.begin(), _rows.end(), line);
+			std::fflush(stdout);
+		}
+
+	private:
+		std::vector<std::string> _header;
+		std::vector<std::vector<std::string>> _rows;
+	};
+
+	// checks may fail on any thread
+	[[nodiscard]] inline std::atomic_size_t& Failures() noexcept
+	{
+		static std::atomic_size_t failures{ 0 };
+		return failures;
+	}
+
+	inline bool Check(bool a_condition, std::string_view a_what, std::source_location a_loc = std::source_location::current())
+	{
+		if (!a_condition) {
+			fmt::print(stderr, FMT_STRING("{}:{}: check failed: {}\n"), a_loc.file_name(), a_loc.line(), a_what);
+			++Failures();
+		}
+		return a_condition;
+	}
+
+	// the exit code of a test
+	[[nodiscard]] inline int Finish(std::string_view a_name)
+	{
+		if (const auto failures = Failures().load(); failures != 0) {
+			fmt::print(stderr, FMT_STRING("{}: {} checks failed\n"), a_name, failures);
+			return EXIT_FAILURE;
+		}
+
+		fmt::print(FMT_STRING("{}: passed\n"), a_name);
+		return EXIT_SUCCESS;
+	}
+}
@@ -0,0 +1,88 @@
+#include "Bench.h"
+
+#include "EditorIDCache.h"
+
+// a session which writes the cache, followed by one which restores it and sees every form confirmed again unchanged
+// the cache can only be installed once per process, so each session is a child running this program with --write or
+// --restore, sharing a temporary log directory
+// a restored cache confirmed without changes must keep its epoch, so the queries' caches stay valid and nothing is rewritten
+
+namespace
+{
+	constexpr std::size_t FORMS = 2'000;
+
+	[[nodiscard]] std::uint32_t FormID(std::size_t a_index) noexcept { return static_cast<std::uint32_t>(0x01000800 + a_index); }
+
+	[[nodiscard]] RE::ENUM_FORM_ID FormType(std::size_t a_index) noexcept
+	{
+		return a_index % 3 == 0 ? RE::ENUM_FORM_ID::kWEAP : RE::ENUM_FORM_ID::kMISC;
+	}
+
+	void Confirm(EditorIDCache& a_cache)
+	{
+		for (std::size_t i = 0; i < FORMS; ++i) {
+			a_cache.insert(FormID(i), fmt::format(FMT_STRING("RestoreTest{:04}"), i), FormType(i));
+		}
+	}
+
+	void Write()
+	{
+		auto& cache = EditorIDCache::get();
+		cache.install(true);
+		Confirm(cache);
+		cache.sync();
+	}
+
+	void Restore(const std::filesystem::path& a_directory)
+	{
+		auto& cache = EditorIDCache::get();
+		cache.install(true);
+		const auto restored = cache.snapshot();
+		bench::Check(restored->size() == FORMS, "every editor id is restored");
+		bench::Check(restored->bucket(RE::ENUM_FORM_ID::kWEAP).size() == (FORMS + 2) / 3, "form types are restored");
+
+		Confirm(cache);
+		bench::Check(cache.snapshot()->epoch() == restored->epoch(), "confirming restored forms unchanged keeps the epoch");
+
+		const auto files = [&]() {
+			return std::distance(std::filesystem::directory_iterator{ a_directory }, std::filesystem::directory_iterator{});
+		};
+		const auto before = files();
+		cache.sync();
+		bench::Check(files() == before, "an unchanged cache isn't written again");
+
+		cache.insert(FormID(0), "RestoreTest0000"sv, RE::ENUM_FORM_ID::kARMO);
+		bench::Check(cache.snapshot()->epoch() != restored->epoch(), "changing a form's type starts a new epoch");
+	}
+
+	[[nodiscard]] bool Spawn(const char* a_self, std::string_view a_phase, const std::filesystem::path& a_directory)
+	{
+		const auto command = fmt::format(FMT_STRING("\"{}\" {} \"{}\""), a_self, a_phase, a_directory.string());
+		return std::system(command.c_str()) == 0;
+	}
+}
+
+int main(int a_argc, char* a_argv[])
+{
+	spdlog::set_level(spdlog::level::warn);
+
+	if (a_argc == 3) {
+		const std::string_view phase{ a_argv[1] };
+		mock::LogDirectory = a_argv[2];
+		if (phase == "--write"sv) {
+			Write();
+		} else if (phase == "--restore"sv) {
+			Restore(a_argv[2]);
+		}
+		return bench::Failures() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	const auto directory = std::filesystem::temp_directory_path() / fmt::format(FMT_STRING("EditorIDCacheRestoreTest.{}"), ::getpid());
+	std::filesystem::create_directories(directory);
+	bench::Check(Spawn(a_argv[0], "--write"sv, directory), "the first session writes the cache");
+	bench::Check(Spawn(a_argv[0], "--restore"sv, directory), "the second session restores it");
+
+	std::error_code ec;
+	std::filesystem::remove_all(directory, ec);
+	return bench::Finish("EditorIDCacheRestoreTest"sv);
+}
@@ -0,0 +1,169 @@
+#include "Bench.h"
+
+#include "EditorIDCache.h"
+
+#include <future>
+#include <random>
+
+// races inserting threads against readers taking snapshots, and checks every snapshot a reader sees is self-consistent
+// writers own disjoint ranges of form ids, and rename every form once, so readers also see editor ids being replaced
+// every editor id encodes the form it belongs to and its version, so a torn or stale entry can be told apart from a valid one
+
+namespace
+{
+	struct Options
+	{
+	public:
+		std::size_t writers{ 8 };
+		std::size_t readers{ 8 };
+		std::size_t forms{ 50'000 };  // per writer
+	};
+
+	[[nodiscard]] std::string MakeEditorID(std::uint32_t a_formID, std::size_t a_version)
+	{
+		return fmt::format(FMT_STRING("Stress{:08X}v{}"), a_formID, a_version);
+	}
+
+	// returns the form id and version an editor id was made from
+	[[nodiscard]] std::optional<std::pair<std::uint32_t, std::size_t>> ParseEditorID(std::string_view a_editorID)
+	{
+		constexpr auto PREFIX = "Stress"sv;
+		if (a_editorID.length() < PREFIX.length() + 10 || !a_editorID.starts_with(PREFIX) || a_editorID[PREFIX.length() + 8] != 'v') {
+			return std::nullopt;
+		}
+
+		std::uint32_t formID = 0;
+		for (const auto ch : a_editorID.substr(PREFIX.length(), 8)) {
+			const auto digit = ch >= '0' && ch <= '9' ? ch - '0' : ch >= 'A' && ch <= 'F' ? ch - 'A' + 10 : -1;
+			if (digit < 0) {
+				return std::nullopt;
+			}
+			formID = (formID << 4) | static_cast<std::uint32_t>(digit);
+		}
+		return std::make_pair(formID, static_cast<std::size_t>(a_editorID[PREFIX.length() + 9] - '0'));
+	}
+
+	[[nodiscard]] std::uint32_t FormID(std::size_t a_writer, std::size_t a_index) noexcept
+	{
+		return static_cast<std::uint32_t>((a_writer + 1) << 24 | a_index);
+	}
+
+	[[nodiscard]] RE::ENUM_FORM_ID FormType(std::uint32_t a_formID) noexcept
+	{
+		return a_formID % 2 == 0 ? RE::ENUM_FORM_ID::kWEAP : RE::ENUM_FORM_ID::kMISC;
+	}
+
+	void Write(const Options& a_options, std::size_t a_writer)
+	{
+		auto& cache = EditorIDCache::get();
+		for (std::size_t version = 0; version < 2; ++version) {
+			for (std::size_t i = 0; i < a_options.forms; ++i) {
+				const auto formID = FormID(a_writer, i);
+				cache.insert(formID, MakeEditorID(formID, version), FormType(formID));
+			}
+		}
+	}
+
+	// returns the number of snapshots checked
+	std::size_t Read(const Options& a_options, const std::atomic_bool& a_done, std::size_t a_reader)
+	{
+		std::mt19937 rng{ static_cast<std::uint32_t>(a_reader) };
+		std::uint64_t lastEpoch = 0;
+		std::size_t lastSize = 0;
+		std::size_t snapshots = 0;
+		for (bool last = false; !last;) {
+			last = a_done.load(std::memory_order_acquire);  // one more pass once the writers are done
+			const auto snapshot = EditorIDCache::get().snapshot();
+			++snapshots;
+
+			bench::Check(snapshot->epoch() >= lastEpoch, "epochs never go backwards");
+			bench::Check(snapshot->size() >= lastSize, "forms are never dropped");
+			lastEpoch = snapshot->epoch();
+			lastSize = snapshot->size();
+
+			for (std::size_t i = 0; i < 0x100; ++i) {
+				const auto writer = std::uniform_int_distribution<std::size_t>{ 0, a_options.writers - 1 }(rng);
+				const auto formID = FormID(writer, std::uniform_int_distribution<std::size_t>{ 0, a_options.forms - 1 }(rng));
+				const auto editorID = snapshot->find(formID);
+				if (!editorID) {
+					continue;
+				}
+
+				const auto parsed = ParseEditorID(*editorID);
+				if (!bench::Check(parsed && parsed->first == formID, "editor ids belong to the form they were inserted for")) {
+					continue;
+				}
+
+				// the reverse map must agree with the forward map within one snapshot
+				bench::Check(snapshot->find(*editorID) == formID, "editor ids resolve back to their form");
+				bench::Check(snapshot->find_folded(formID).has_value(), "folded editor ids are published alongside");
+				if (parsed->second == 1) {
+					bench::Check(!snapshot->find(MakeEditorID(formID, 0)), "renamed forms drop their old editor id");
+				}
+				bench::Check(snapshot->find(*editorID) == snapshot->find(*editorID), "snapshots never change");
+			}
+
+			// the indices derived from a snapshot are built lazily, by whichever reader gets there first
+			if (snapshots % 16 == 0) {
+				const auto bucket = snapshot->bucket(RE::ENUM_FORM_ID::kWEAP);
+				bench::Check(std::is_sorted(bucket.begin(), bucket.end()), "buckets are sorted");
+				bench::Check(std::all_of(bucket.begin(), bucket.end(), [](auto a_formID) { return FormType(a_formID) == RE::ENUM_FORM_ID::kWEAP; }), "buckets only hold their type");
+			}
+		}
+		return snapshots;
+	}
+}
+
+int main(int a_argc, char* a_argv[])
+{
+	spdlog::set_level(spdlog::level::warn);
+	Options options;
+	if (bench::Quick(a_argc, a_argv)) {
+		options.writers = 4;
+		options.readers = 4;
+		options.forms = 10'000;
+	}
+
+	EditorIDCache::get().install(true);
+
+	const auto start = bench::clock_type::now();
+	std::atomic_bool done{ false };
+	std::vector<std::future<std::size_t>> readers;
+	for (std::size_t i = 0; i < options.readers; ++i) {
+		readers.push_back(std::async(std::launch::async, Read, std::cref(options), std::cref(done), i));
+	}
+	{
+		std::vector<std::jthread> writers;
+		for (std::size_t i = 0; i < options.writers; ++i) {
+			writers.emplace_back(Write, std::cref(options), i);
+		}
+	}
+	done.store(true, std::memory_order_release);
+
+	std::size_t snapshots = 0;
+	for (auto& reader : readers) {
+		snapshots += reader.get();
+	}
+
+	// once the writers are done, every form must be published with its final editor id
+	const auto snapshot = EditorIDCache::get().snapshot();
+	bench::Check(snapshot->size() == options.writers * options.forms, "every form is published");
+	for (std::size_t writer = 0; writer < options.writers; ++writer) {
+		for (std::size_t i = 0; i < options.forms; ++i) {
+			const auto formID = FormID(writer, i);
+			const auto editorID = snapshot->find(formID);
+			if (!bench::Check(editorID && *editorID == MakeEditorID(formID, 1), "every form ends up with its final editor id")) {
+				return bench::Finish("EditorIDCacheStressTest"sv);
+			}
+		}
+	}
+
+	fmt::print(
+		FMT_STRING("{} writers inserted {} editor ids twice while {} readers checked {} snapshots, in {}\n"),
+		options.writers,
+		options.writers * options.forms,
+		options.readers,
+		snapshots,
+		bench::FormatDuration(static_cast<double>(bench::Elapsed(start).count())));
+	return bench::Finish("EditorIDCacheStressTest"sv);
+}
@@ -0,0 +1,149 @@
+#include "Bench.h"
+
+#include "EditorIDFile.h"
+
+#include <random>
+
+// writes editor id cache files and reads them back, both intact and damaged in every way a file left behind by a
+// crashed or older session could be
+// files read back are adopted by an empty arena the way the cache restores them, so every handle is checked to view
+// the string it was written for
+
+namespace
+{
+	struct Written
+	{
+	public:
+		std::vector<char> bytes;
+		std::map<std::uint32_t, std::string> editorIDs;
+	};
+
+	[[nodiscard]] std::vector<char> ReadFile(const std::filesystem::path& a_path)
+	{
+		std::ifstream file{ a_path, std::ios::binary };
+		return { std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+	}
+
+	[[nodiscard]] std::uint8_t FormType(std::uint32_t a_formID) noexcept { return static_cast<std::uint8_t>(a_formID % 0x9F); }
+
+	// enough editor ids to fill several chunks, plus one larger than a chunk, so strings have to be realigned
+	[[nodiscard]] Written Write(const std::filesystem::path& a_path, std::size_t a_count, bool a_folded)
+	{
+		std::mt19937 rng{ 0x5EED };
+		StringArena arena;
+		Written written;
+		std::vector<EditorIDFile::Record> records;
+		for (std::size_t i = 0; i <= a_count; ++i) {
+			const auto formID = static_cast<std::uint32_t>(rng());
+			auto editorID = i == a_count ?
+                                std::string(StringArena::CHUNK_SIZE + 7, 'X') :
+                                fmt::format(FMT_STRING("TestEditorID{:08X}{}"), formID, std::string(rng() % 64, 'a'));
+			if (!written.editorIDs.try_emplace(formID, editorID).second) {
+				continue;
+			}
+
+			records.push_back({ formID, a_folded ? arena.push_back_folded(editorID) : arena.push_back(editorID), FormType(formID) });
+		}
+
+		bench::Check(EditorIDFile::Write(a_path, 0xF1F1F1F1, a_folded, records, arena), "files are written");
+		bench::Check(!std::filesystem::exists(a_path.string() + ".tmp"), "the temporary file is renamed into place");
+		bench::Check(
+			std::is_sorted(records.begin(), records.end(), [](auto&& a_lhs, auto&& a_rhs) { return a_lhs.formID < a_rhs.formID; }),
+			"records are written in form id order");
+		written.bytes = ReadFile(a_path);
+		return written;
+	}
+
+	void CheckRoundTrip(const std::filesystem::path& a_path, bool a_folded)
+	{
+		const auto written = Write(a_path, 100'000, a_folded);
+		const auto file = EditorIDFile::Read(written.bytes);
+		if (!bench::Check(file.has_value(), "intact files are read back")) {
+			return;
+		}
+
+		bench::Check(file->header().fingerprint == 0xF1F1F1F1, "the fingerprint is kept");
+		bench::Check(file->folded() == a_folded, "the folded flag is kept");
+		bench::Check(file->size() == written.editorIDs.size(), "every record is kept");
+
+		StringArena arena;
+		arena.adopt(file->strings());
+		std::size_t matched = 0;
+		for (std::size_t i = 0; i < file->size(); ++i) {
+			const auto record = file->record(i);
+			if (!bench::Check(record.has_value(), "every record lies within the file")) {
+				continue;
+			}
+
+			const auto it = written.editorIDs.find(record->formID);
+			if (!bench::Check(it != written.editorIDs.end(), "records hold the form ids they were written with")) {
+				continue;
+			}
+
+			bench::Check(record->formType == FormType(record->formID), "form types are kept");
+			const auto offset = record->handle.offset & (StringArena::CHUNK_SIZE - 1);
+			bench::Check(
+				offset + record->handle.length * (a_folded ? 2 : 1) <= StringArena::CHUNK_SIZE || offset == 0,
+				"strings only straddle a chunk boundary if they are larger than a chunk");
+			if (bench::Check(arena.view(record->handle) == it->second, "handles view the editor id they were written for")) {
+				++matched;
+			}
+
+			if (a_folded) {
+				std::string folded{ it->second };
+				std::transform(folded.begin(), folded.end(), folded.begin(), stl::tolower);
+				bench::Check(arena.view_folded(record->handle) == folded, "the folded copy is written after the editor id");
+			}
+		}
+		bench::Check(matched == written.editorIDs.size(), "every editor id is read back");
+	}
+
+	void CheckCorruption(const std::filesystem::path& a_path)
+	{
+		const auto written = Write(a_path, 1'000, true);
+		const auto expect = [&](std::string_view a_what, auto&& a_damage) {
+			auto bytes = written.bytes;
+			a_damage(bytes);
+			bench::Check(!EditorIDFile::Read(bytes), a_what);
+		};
+
+		// the checksum covers every byte after the header, which is checked field by field
+		const auto records = sizeof(EditorIDFile::Header);
+		const auto strings = records + written.editorIDs.size() * sizeof(EditorIDFile::Record);
+		expect("empty files are rejected"sv, [](auto& a_bytes) { a_bytes.clear(); });
+		expect("files shorter than a header are rejected"sv, [](auto& a_bytes) { a_bytes.resize(sizeof(EditorIDFile::Header) - 1); });
+		expect("truncated files are rejected"sv, [](auto& a_bytes) { a_bytes.pop_back(); });
+		expect("extended files are rejected"sv, [](auto& a_bytes) { a_bytes.push_back('\0'); });
+		expect("a bad magic is rejected"sv, [](auto& a_bytes) { a_bytes[0] = 'X'; });
+		expect("other versions are rejected"sv, [](auto& a_bytes) { ++a_bytes[offsetof(EditorIDFile::Header, version)]; });
+		expect("a bad record count is rejected"sv, [](auto& a_bytes) { ++a_bytes[offsetof(EditorIDFile::Header, count)]; });
+		expect("a bad checksum is rejected"sv, [](auto& a_bytes) { ++a_bytes[offsetof(EditorIDFile::Header, checksum)]; });
+		expect("damaged records are rejected"sv, [&](auto& a_bytes) { a_bytes[records + 5] ^= 0x10; });
+		expect("damaged strings are rejected"sv, [&](auto& a_bytes) { a_bytes[strings + 3] ^= 0x01; });
+		expect("damaged trailing strings are rejected"sv, [](auto& a_bytes) { a_bytes.back() ^= 0x01; });
+
+		// the folded flag isn't covered by the checksum, since it's left for the reader to compare with its own options
+		auto bytes = written.bytes;
+		bytes[offsetof(EditorIDFile::Header, flags)] ^= EditorIDFile::Header::kFolded;
+		const auto file = EditorIDFile::Read(bytes);
+		bench::Check(file && !file->folded(), "files written with other options are told apart");
+	}
+}
+
+int main()
+{
+	spdlog::set_level(spdlog::level::err);  // the failed write below warns
+	const auto directory = std::filesystem::temp_directory_path() / fmt::format(FMT_STRING("EditorIDFileTest.{}"), ::getpid());
+	std::filesystem::create_directories(directory);
+
+	CheckRoundTrip(directory / "unfolded.cache", false);
+	CheckRoundTrip(directory / "folded.cache", true);
+	CheckCorruption(directory / "corrupt.cache");
+
+	std::vector<EditorIDFile::Record> none;
+	bench::Check(!EditorIDFile::Write(directory / "missing" / "none.cache", 0, false, none, StringArena{}), "failed writes are reported");
+
+	std::error_code ec;
+	std::filesystem::remove_all(directory, ec);
+	return bench::Finish("EditorIDFileTest"sv);
+}
@@ -0,0 +1,147 @@
+#include "Bench.h"
+#include "LoadOrder.h"
+
+#include "EditorIDCache.h"
+#include "StringArena.h"
+
+#include <random>
+
+// the memory footprint of the editor id storage, one std::string per form as the cache used to hold them against
+// handles into a shared arena, and the cache itself with its reverse map and form types on top
+// every layout is filled with the same editor ids in the same order, and measured while it's still alive
+
+namespace
+{
+	struct Generated
+	{
+	public:
+		std::uint32_t formID{ 0 };
+		std::string editorID;
+	};
+
+	// editor ids shaped like the game's, a few capitalized words with the odd number on the end
+	[[nodiscard]] std::vector<Generated> MakeEditorIDs(std::size_t a_count)
+	{
+		const auto words = bench::LoadOrder::Words();
+		std::mt19937_64 rng{ 0x5EED };
+		std::vector<Generated> result;
+		result.reserve(a_count);
+		for (std::size_t i = 0; i < a_count; ++i) {
+			std::string editorID;
+			const auto count = std::uniform_int_distribution<std::size_t>{ 1, 4 }(rng);
+			for (std::size_t j = 0; j < count; ++j) {
+				editorID += words[std::uniform_int_distribution<std::size_t>{ 0, words.size() - 1 }(rng)];
+			}
+			if (rng() % 3 == 0) {
+				editorID += fmt::format(FMT_STRING("{:02}"), rng() % 100);
+			}
+			const auto formID = (i / 0x2000) << 24 | (0x800 + i % 0x2000);  // spread across plugins
+			result.push_back({ static_cast<std::uint32_t>(formID), std::move(editorID) });
+		}
+		return result;
+	}
+
+	struct Result
+	{
+	public:
+		std::chrono::nanoseconds elapsed{ 0 };
+		bench::Allocations allocations;
+		std::size_t heap{ 0 };  // still live once the layout is filled
+	};
+
+	// fills a layout, then measures it before it's destroyed
+	template <class Fill>
+	[[nodiscard]] Result Measure(Fill&& a_fill)
+	{
+		const auto heap = bench::HeapBytes();
+		const auto allocations = bench::ProcessAllocations();
+		const auto start = bench::clock_type::now();
+
+		Result result;
+		a_fill([&]() {
+			result.elapsed = bench::Elapsed(start);
+			result.allocations = bench::ProcessAllocations() - allocations;
+			result.heap = bench::HeapBytes() - heap;
+		});
+		return result;
+	}
+
+	[[nodiscard]] Result MeasureStrings(std::span<const Generated> a_editorIDs)
+	{
+		return Measure([&](auto&& a_done) {
+			robin_hood::unordered_flat_map<std::uint32_t, std::string> map;
+			for (const auto& [formID, editorID] : a_editorIDs) {
+				map.insert_or_assign(formID, editorID);
+			}
+			a_done();
+
+			for (const auto& [formID, editorID] : a_editorIDs) {
+				bench::Check(map.find(formID)->second == editorID, "strings are stored as inserted");
+			}
+		});
+	}
+
+	[[nodiscard]] Result MeasureArena(std::span<const Generated> a_editorIDs, bool a_folded)
+	{
+		return Measure([&](auto&& a_done) {
+			StringArena arena;
+			robin_hood::unordered_flat_map<std::uint32_t, StringArena::handle_type> map;
+			for (const auto& [formID, editorID] : a_editorIDs) {
+				map.insert_or_assign(formID, a_folded ? arena.push_back_folded(editorID) : arena.push_back(editorID));
+			}
+			a_done();
+
+			for (const auto& [formID, editorID] : a_editorIDs) {
+				bench::Check(arena.view(map.find(formID)->second) == editorID, "handles view the string they were made for");
+			}
+		});
+	}
+
+	[[nodiscard]] Result MeasureCache(std::span<const Generated> a_editorIDs)
+	{
+		return Measure([&](auto&& a_done) {
+			auto& cache = EditorIDCache::get();
+			for (const auto& [formID, editorID] : a_editorIDs) {
+				cache.insert(formID, editorID, RE::ENUM_FORM_ID::kMISC);
+			}
+			a_done();
+
+			const auto snapshot = cache.snapshot();
+			for (const auto& [formID, editorID] : a_editorIDs) {
+				bench::Check(snapshot->find(formID) == editorID, "the cache holds every editor id");
+			}
+		});
+	}
+}
+
+int main(int a_argc, char* a_argv[])
+{
+	spdlog::set_level(spdlog::level::warn);
+	const std::size_t count = bench::Quick(a_argc, a_argv) ? 20'000 : 500'000;
+	const auto editorIDs = MakeEditorIDs(count);
+	const auto characters = std::accumulate(editorIDs.begin(), editorIDs.end(), std::size_t{ 0 }, [](std::size_t a_sum, const Generated& a_elem) {
+		return a_sum + a_elem.editorID.length();
+	});
+
+	EditorIDCache::get().install(true);
+
+	bench::Table table{ { "layout", "fill", "allocs", "allocated", "heap", "heap/form" } };
+	const auto add = [&](std::string_view a_label, const Result& a_result) {
+		table.add({
+			std::string{ a_label },
+			bench::FormatDuration(static_cast<double>(a_result.elapsed.count())),
+			fmt::format(FMT_STRING("{}"), a_result.allocations.count),
+			bench::FormatBytes(static_cast<double>(a_result.allocations.bytes)),
+			bench::FormatBytes(static_cast<double>(a_result.heap)),
+			fmt::format(FMT_STRING("{:.1f} B"), static_cast<double>(a_result.heap) / static_cast<double>(count)),
+		});
+	};
+
+	add("std::string per form"sv, MeasureStrings(editorIDs));
+	add("arena handles"sv, MeasureArena(editorIDs, false));
+	add("arena handles, folded"sv, MeasureArena(editorIDs, true));
+	add("EditorIDCache, folded"sv, MeasureCache(editorIDs));  // last, the singleton is never torn down
+	table.print(fmt::format(FMT_STRING("{} editor ids, {} of text"), count, bench::FormatBytes(static_cast<double>(characters))));
+
+	return bench::Finish("EditorIDMemoryBench"sv);
+}
@@ -0,0 +1,169 @@
+#include "Bench.h"
+#include "LoadOrder.h"
+
+#include "CC/Help.h"
+
+// latency, throughput and allocations of every Help section, on a synthetic load order
+// a query is timed in its three phases, the snapshot on the console thread, the run on the worker, and printing the
+// blocks it posted on the ui thread, all of which run on this thread here
+// cases which cycle through several match strings never refine a previous match set, so every run is a full search
+// cases which churn created forms before every run check the refinement outlives them
+
+namespace
+{
+	using CC::Help::detail::Filter;
+
+	struct Case
+	{
+	public:
+		std::string label;
+		std::vector<std::string> matchstrings;
+		Filter filter{ Filter::kAll };
+		std::optional<std::string> formtype;
+		std::int32_t limit{ 0 };
+		std::size_t churn{ 0 };
+	};
+
+	struct Result
+	{
+	public:
+		bench::Samples snapshot;
+		bench::Samples run;
+		bench::Samples print;
+		bench::Samples total;
+		bench::Allocations allocations;
+		std::size_t appends{ 0 };
+		std::size_t bytes{ 0 };
+	};
+
+	[[nodiscard]] Result Measure(bench::LoadOrder& a_loadOrder, const Case& a_case, std::size_t a_iterations)
+	{
+		namespace Help = CC::Help::detail;
+
+		const auto once = [&](std::size_t a_index, Result* a_result) {
+			const auto log = RE::ConsoleLog::GetSingleton();
+			const auto appends = log->appends;
+			const auto bytes = log->bytes;
+			a_loadOrder.churn(a_case.churn);
+			const auto allocations = bench::ProcessAllocations();
+
+			const auto start = bench::clock_type::now();
+			auto query = Help::MakeQuery(
+				a_case.matchstrings[a_index % a_case.matchstrings.size()],
+				a_case.filter,
+				a_case.formtype.value_or("*"s),
+				a_case.limit,
+				1);
+			if (!bench::Check(query != nullptr, a_case.label)) {
+				return;
+			}
+			Help::Snapshot(*query);
+			const auto snapshot = bench::clock_type::now();
+			if (a_case.churn != 0 && a_result) {
+				bench::Check(query->refined, "refinements outlive created forms churning");
+				bench::Check(query->created && query->created->records.size() == a_loadOrder.created().size(), "every live created form is snapshot, and no destroyed one");
+			}
+			Help::Run(*query, std::stop_token{});
+			const auto run = bench::clock_type::now();
+			mock::RunUITasks();
+			query.reset();
+			const auto print = bench::clock_type::now();
+
+			if (a_result) {
+				a_result->snapshot.push_back(snapshot - start);
+				a_result->run.push_back(run - snapshot);
+				a_result->print.push_back(print - run);
+				a_result->total.push_back(print - start);
+				const auto allocated = bench::ProcessAllocations() - allocations;
+				a_result->allocations.count += allocated.count;
+				a_result->allocations.bytes += allocated.bytes;
+				a_result->appends += log->appends - appends;
+				a_result->bytes += log->bytes - bytes;
+			}
+		};
+
+		// the first run builds the caches every later query shares
+		once(0, nullptr);
+
+		Result result;
+		for (std::size_t i = 0; i < a_iterations; ++i) {
+			once(i + 1, std::addressof(result));
+		}
+		return result;
+	}
+}
+
+int main(int a_argc, char* a_argv[])
+{
+	const auto quick = bench::Quick(a_argc, a_argv);
+	spdlog::set_level(spdlog::level::warn);
+
+	const auto options = quick ? bench::LoadOrderOptions::Quick() : bench::LoadOrderOptions{};
+	const auto generateStart = bench::clock_type::now();
+	auto& loadOrder = bench::LoadOrder::Generate(options);
+	fmt::print(
+		FMT_STRING("generated {} plugin forms, {} created forms and {} editor ids in {}\n"),
+		options.forms,
+		options.created,
+		EditorIDCache::get().snapshot()->size(),
+		bench::FormatDuration(static_cast<double>(bench::Elapsed(generateStart).count())));
+
+	const std::vector<Case> cases{
+		{ "functions", { "get", "set" }, Filter::kFunctions },
+		{ "settings", { "combat", "vault" }, Filter::kSettings },
+		{ "globals", { "quest", "power" }, Filter::kGlobals },
+		{ "forms, substring", { "deathclaw", "mirelurk" }, Filter::kForms },
+		{ "forms, short substring", { "ca", "ol" }, Filter::kForms },
+		{ "forms, refined", { "laser" }, Filter::kForms },
+		{ "forms, refined, created forms churning", { "laser" }, Filter::kForms, std::nullopt, 0, 100 },
+		{ "forms, paged", { "combat", "raider" }, Filter::kForms, std::nullopt, 20 },
+		{ "forms of a bucketed type", { "rifle", "pistol" }, Filter::kForms, "WEAP"s },
+		{ "forms of an unbucketed type", { "rifle", "pistol" }, Filter::kForms, "REFR"s },
+		{ "forms, glob", { "*laser*rifle*", "plasma?*" }, Filter::kForms },
+		{ "forms, regex", { "/.*(laser|plasma)(rifle|pistol).*/", "/[a-z]+core[0-9]+/" }, Filter::kForms },
+		{ "forms, terms", { "laser rifle | plasma", "combat armor" }, Filter::kForms },
+		{ "all, paged", { "combat", "vault" }, Filter::kAll, std::nullopt, 20 },
+		{ "editor id", { std::string{ loadOrder.sampleEditorID() }, std::string{ loadOrder.sampleEditorID() } }, Filter::kEditorID },
+	};
+
+	const std::size_t iterations = quick ? 3 : 20;
+	bench::Table table{ { "path", "snapshot", "run", "print", "total p50", "total p99", "throughput", "allocs/query", "allocated/query", "appends/query", "output/query" } };
+	for (const auto& c : cases) {
+		const auto result = Measure(loadOrder, c, iterations);
+		if (result.total.empty()) {
+			continue;
+		}
+
+		const auto n = static_cast<double>(result.total.size());
+		table.add({
+			c.label,
+			bench::FormatDuration(result.snapshot.median()),
+			bench::FormatDuration(result.run.median()),
+			bench::FormatDuration(result.print.median()),
+			bench::FormatDuration(result.total.median()),
+			bench::FormatDuration(result.total.p99()),
+			bench::FormatRate(1e9 / result.total.mean(), "queries"sv),
+			fmt::format(FMT_STRING("{:.0f}"), static_cast<double>(result.allocations.count) / n),
+			bench::FormatBytes(static_cast<double>(result.allocations.bytes) / n),
+			fmt::format(FMT_STRING("{:.1f}"), static_cast<double>(result.appends) / n),
+			bench::FormatBytes(static_cast<double>(result.bytes) / n),
+		});
+	}
+	table.print(fmt::format(FMT_STRING("help queries, median of {} runs"), iterations));
+
+	// loading a save replaces the name table, after which no match set found with the old names may be refined
+	const auto refined = [](std::string a_matchstring) {
+		namespace Help = CC::Help::detail;
+		const auto query = Help::MakeQuery(std::move(a_matchstring), Filter::kForms, "*"s, 0, 1);
+		Help::Snapshot(*query);
+		Help::Run(*query, std::stop_token{});
+		mock::RunUITasks();
+		return query->refined;
+	};
+	static_cast<void>(refined("laser"s));
+	bench::Check(refined("laserrifle"s), "narrowed queries refine the last match set");
+	DisplayNameCache::get().invalidate();
+	bench::Check(!refined("laserrifle"s), "a new name table discards refinements");
+
+	return bench::Finish("EnumerateBench"sv);
+}
@@ -0,0 +1,112 @@
+#include "Bench.h"
+#include "LoadOrder.h"
+
+#include "CC/Help.h"
+
+#if defined(BENCH_HAS_TBB)
+#	include <tbb/global_control.h>
+#endif
+
+// how the worker's half of a Help query scales with the threads the parallel algorithms may use, from one up to
+// every hardware thread
+// only the run is timed, since the snapshot is taken on the console thread and printing happens on the ui thread
+
+namespace
+{
+	struct Case
+	{
+	public:
+		std::string_view label;
+		std::vector<std::string> matchstrings;
+		std::int32_t limit{ 0 };
+	};
+
+	[[nodiscard]] bench::Samples Measure(const Case& a_case, std::size_t a_iterations)
+	{
+		namespace Help = CC::Help::detail;
+
+		bench::Samples samples;
+		for (std::size_t i = 0; i <= a_iterations; ++i) {
+			const auto query = Help::MakeQuery(a_case.matchstrings[i % a_case.matchstrings.size()], Help::Filter::kForms, "*"s, a_case.limit, 1);
+			if (!bench::Check(query != nullptr, a_case.label)) {
+				break;
+			}
+
+			Help::Snapshot(*query);
+			const auto start = bench::clock_type::now();
+			Help::Run(*query, std::stop_token{});
+			const auto elapsed = bench::Elapsed(start);
+			mock::RunUITasks();
+			if (i != 0) {  // the first builds the caches every later query shares
+				samples.push_back(elapsed);
+			}
+		}
+		return samples;
+	}
+
+	[[nodiscard]] std::vector<std::size_t> ThreadCounts()
+	{
+		const auto hardware = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+		std::vector<std::size_t> result;
+		for (std::size_t threads = 1; threads < hardware; threads *= 2) {
+			result.push_back(threads);
+		}
+		result.push_back(hardware);
+		return result;
+	}
+}
+
+int main(int a_argc, char* a_argv[])
+{
+	const auto quick = bench::Quick(a_argc, a_argv);
+	spdlog::set_level(spdlog::level::warn);
+
+#if !defined(BENCH_HAS_TBB)
+	fmt::print("built without TBB, so the parallel algorithms run serially and only one thread is measured\n");
+#endif
+
+	const auto options = quick ? bench::LoadOrderOptions::Quick() : bench::LoadOrderOptions{};
+	bench::LoadOrder::Generate(options);
+
+	const std::vector<Case> cases{
+		{ "substring"sv, { "deathclaw", "mirelurk" } },
+		{ "substring, paged"sv, { "combat", "raider" }, 20 },
+		{ "glob"sv, { "*laser*rifle*", "plasma?*" } },
+		{ "terms"sv, { "laser rifle | plasma", "combat armor" } },
+	};
+
+	const std::size_t iterations = quick ? 3 : 20;
+	bench::Table table{ { "query", "threads", "run p50", "run p99", "speedup", "efficiency" } };
+	for (const auto& c : cases) {
+		double serial = 0.0;
+		for (const auto threads : ThreadCounts()) {
+#if defined(BENCH_HAS_TBB)
+			const tbb::global_control control{ tbb::global_control::max_allowed_parallelism, threads };
+#else
+			if (threads != 1) {
+				break;
+			}
+#endif
+			const auto samples = Measure(c, iterations);
+			if (samples.empty()) {
+				break;
+			}
+
+			if (threads == 1) {
+				serial = samples.median();
+			}
+			const auto speedup = serial / samples.median();
+			table.add({
+				std::string{ c.label },
+				fmt::format(FMT_STRING("{}"), threads),
+				bench::FormatDuration(samples.median()),
+				bench::FormatDuration(samples.p99()),
+				fmt::format(FMT_STRING("{:.2f}x"), speedup),
+				fmt::format(FMT_STRING("{:.0f}%"), speedup / static_cast<double>(threads) * 100.0),
+			});
+		}
+	}
+	table.print(fmt::format(FMT_STRING("form queries by thread count, median of {} runs"), iterations));
+
+	return bench::Finish("EnumerateScalingBench"sv);
+}
@@ -0,0 +1,103 @@
+#include "Bench.h"
+#include "LoadOrder.h"
+
+#include "CC/Help.h"
+
+#include <cstdio>
+
+// the cost and payoff of bFoldCase, which keeps a lowercase copy of every editor id
+// the cache can only be installed once per process, so each setting is measured by a child running this program with
+// --fold=0 or --fold=1, which reports its numbers back on a single line
+
+namespace
+{
+	struct Result
+	{
+	public:
+		double generate{ 0.0 };  // nanoseconds
+		double heap{ 0.0 };      // bytes
+		double p50{ 0.0 };       // nanoseconds
+		double p99{ 0.0 };       // nanoseconds
+	};
+
+	[[nodiscard]] Result Measure(bool a_quick, bool a_foldCase)
+	{
+		Result result;
+		const auto options = a_quick ? bench::LoadOrderOptions::Quick() : bench::LoadOrderOptions{};
+		const auto heap = bench::HeapBytes();
+		const auto start = bench::clock_type::now();
+		bench::LoadOrder::Generate(options, a_foldCase);
+		result.generate = static_cast<double>(bench::Elapsed(start).count());
+		result.heap = static_cast<double>(bench::HeapBytes() - heap);
+
+		// only the searches over editor ids differ, and every query is a full search since none refines the last
+		namespace Help = CC::Help::detail;
+		constexpr std::array NEEDLES{ "deathclaw"sv, "mirelurk"sv, "rifle"sv, "pistol"sv, "*laser*"sv, "combat armor"sv };
+		const std::size_t iterations = a_quick ? 6 : 60;
+		bench::Samples samples;
+		for (std::size_t i = 0; i <= iterations; ++i) {
+			const auto queryStart = bench::clock_type::now();
+			const auto query = Help::MakeQuery(std::string{ NEEDLES[i % NEEDLES.size()] }, Help::Filter::kForms, "*"s, 20, 1);
+			if (!bench::Check(query != nullptr, "queries are made")) {
+				break;
+			}
+			Help::Snapshot(*query);
+			Help::Run(*query, std::stop_token{});
+			mock::RunUITasks();
+			if (i != 0) {  // the first builds the caches every later query shares
+				samples.push_back(bench::Elapsed(queryStart));
+			}
+		}
+		result.p50 = samples.median();
+		result.p99 = samples.p99();
+		return result;
+	}
+
+	[[nodiscard]] std::optional<Result> Spawn(const char* a_self, bool a_quick, bool a_foldCase)
+	{
+		const auto command = fmt::format(FMT_STRING("\"{}\" --fold={}{}"), a_self, a_foldCase ? 1 : 0, a_quick ? " --quick" : "");
+		const auto pipe = ::popen(command.c_str(), "r");
+		if (!pipe) {
+			return std::nullopt;
+		}
+
+		Result result;
+		const auto read = std::fscanf(pipe, "%lf %lf %lf %lf", &result.generate, &result.heap, &result.p50, &result.p99);
+		const auto status = ::pclose(pipe);
+		return read == 4 && status == 0 ? std::make_optional(result) : std::nullopt;
+	}
+}
+
+int main(int a_argc, char* a_argv[])
+{
+	const auto quick = bench::Quick(a_argc, a_argv);
+	spdlog::set_level(spdlog::level::warn);
+
+	for (int i = 1; i < a_argc; ++i) {
+		if (const std::string_view arg{ a_argv[i] }; arg.starts_with("--fold="sv)) {
+			spdlog::set_level(spdlog::level::err);  // stdout is the parent's pipe
+			const auto result = Measure(quick, arg == "--fold=1"sv);
+			fmt::print(FMT_STRING("{} {} {} {}\n"), result.generate, result.heap, result.p50, result.p99);
+			return bench::Failures() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+		}
+	}
+
+	bench::Table table{ { "bFoldCase", "generate", "heap", "query p50", "query p99" } };
+	for (const auto foldCase : { true, false }) {
+		const auto result = Spawn(a_argv[0], quick, foldCase);
+		if (!bench::Check(result.has_value(), "every setting is measured")) {
+			continue;
+		}
+
+		table.add({
+			foldCase ? "1"s : "0"s,
+			bench::FormatDuration(result->generate),
+			bench::FormatBytes(result->heap),
+			bench::FormatDuration(result->p50),
+			bench::FormatDuration(result->p99),
+		});
+	}
+	table.print("form searches with and without case folded editor ids"sv);
+
+	return bench::Finish("FoldCaseBench"sv);
+}
@@ -0,0 +1,77 @@
+#include "Bench.h"
+#include "LoadOrder.h"
+
+#include "CC/Help.h"
+
+// formats every form the way Help's output loop does, into one buffer which is cleared whenever a block would be posted
+// once a first pass has resolved every display name, a second pass over the same forms must not allocate at all
+
+namespace
+{
+	namespace Help = CC::Help::detail;
+
+	[[nodiscard]] std::size_t FormatAll(
+		Help::buffer_type& a_buf,
+		const Help::FormSet& a_forms,
+		const EditorIDCache::Cache& a_idCache,
+		DisplayNameCache::Table& a_names)
+	{
+		std::size_t lines = 0;
+		for (const auto& record : a_forms.records) {
+			Help::FormatForm(a_buf, record, a_idCache, a_names);
+			++lines;
+			if (a_buf.size() >= Help::Output::FLUSH_SIZE) {
+				a_buf.clear();
+			}
+		}
+		return lines;
+	}
+}
+
+int main(int a_argc, char* a_argv[])
+{
+	const auto quick = bench::Quick(a_argc, a_argv);
+	spdlog::set_level(spdlog::level::warn);
+
+	auto& loadOrder = bench::LoadOrder::Generate(quick ? bench::LoadOrderOptions::Quick() : bench::LoadOrderOptions{});
+	const auto idCache = EditorIDCache::get().snapshot();
+	const auto names = DisplayNameCache::get().table();
+
+	Help::FormSet forms;
+	for (const auto& generated : loadOrder.forms()) {
+		if (const auto form = RE::TESForm::GetFormByID(generated.formID); form) {
+			forms.push_back(*form);
+		}
+	}
+	for (const auto formID : loadOrder.created()) {
+		if (const auto form = RE::TESForm::GetFormByID(formID); form) {
+			forms.push_back(*form);
+		}
+	}
+	bench::Check(!forms.records.empty(), "there are forms to format");
+
+	Help::buffer_type buf;
+	buf.reserve(Help::Output::FLUSH_SIZE * 2);
+
+	// the first pass resolves the display names, which the name table keeps
+	bench::Check(FormatAll(buf, forms, *idCache, *names) == forms.records.size(), "every form is formatted");
+
+	buf.clear();
+	const auto before = bench::ThreadAllocations();
+	const auto lines = FormatAll(buf, forms, *idCache, *names);
+	const auto allocated = bench::ThreadAllocations() - before;
+	bench::Check(allocated.count == 0, "formatting lines into a reserved buffer doesn't allocate");
+	fmt::print(FMT_STRING("formatted {} forms with {} allocations, {}\n"), lines, allocated.count, bench::FormatBytes(static_cast<double>(allocated.bytes)));
+
+	const auto& sample = forms.records.front();
+	buf.clear();
+	Help::FormatForm(buf, sample, *idCache, *names);
+	const std::string_view line{ buf.data(), buf.size() };
+	bench::Check(line.find(fmt::format(FMT_STRING("({:08X})"), sample.formID)) != std::string_view::npos, "form ids are written as eight hex digits");
+	bench::Check(line.ends_with('\n'), "every form is a line of its own");
+	if (const auto editorID = idCache->find(sample.formID); editorID) {
+		bench::Check(line.find(*editorID) != std::string_view::npos, "editor ids are written");
+	}
+
+	return bench::Finish("FormatFormTest"sv);
+}
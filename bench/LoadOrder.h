@@ -0,0 +1,375 @@
+#pragma once
+
+// synthetic load orders shaped like a heavily modded game, generated deterministically from a seed
+// references make up most of the forms and rarely have editor ids, while base objects almost always do, and items carry
+// display names built from the same vocabulary as their editor ids, so searches hit both
+
+#include "CreatedForms.h"
+#include "EditorIDCache.h"
+#include "FunctionIndex.h"
+
+#include <deque>
+#include <random>
+
+namespace bench
+{
+	struct LoadOrderOptions
+	{
+	public:
+		[[nodiscard]] static LoadOrderOptions Quick() noexcept
+		{
+			LoadOrderOptions options;
+			options.plugins = 16;
+			options.forms = 20'000;
+			options.created = 2'000;
+			options.settings = 400;
+			options.gameSettings = 300;
+			options.globals = 200;
+			return options;
+		}
+
+		std::size_t plugins{ 250 };
+		std::size_t forms{ 500'000 };  // loaded from plugins
+		std::size_t created{ 50'000 };  // created at runtime, which never have editor ids
+		std::size_t settings{ 3'000 };
+		std::size_t gameSettings{ 2'500 };
+		std::size_t globals{ 1'500 };
+		std::size_t consoleFunctions{ 550 };
+		std::size_t scriptFunctions{ 900 };
+		std::uint64_t seed{ 0x5EED };
+	};
+
+	class LoadOrder
+	{
+	public:
+		struct Generated
+		{
+		public:
+			std::uint32_t formID{ 0 };
+			std::string editorID;  // empty if the form has none
+		};
+
+		LoadOrder(const LoadOrder&) = delete;
+		LoadOrder(LoadOrder&&) = delete;
+
+		LoadOrder& operator=(const LoadOrder&) = delete;
+		LoadOrder& operator=(LoadOrder&&) = delete;
+
+		[[nodiscard]] static std::span<const std::string_view> Words() noexcept
+		{
+			static constexpr std::array WORDS{
+				"Laser"sv, "Rifle"sv, "Pistol"sv, "Combat"sv, "Armor"sv, "Leather"sv, "Metal"sv, "Raider"sv,
+				"Synth"sv, "Institute"sv, "Brotherhood"sv, "Minuteman"sv, "Settler"sv, "Workshop"sv, "Vault"sv, "Ghoul"sv,
+				"Mutant"sv, "Deathclaw"sv, "Radroach"sv, "Mirelurk"sv, "Power"sv, "Fusion"sv, "Core"sv, "Plasma"sv,
+				"Gauss"sv, "Missile"sv, "Launcher"sv, "Shotgun"sv, "Pipe"sv, "Revolver"sv, "Stimpak"sv, "RadAway"sv,
+				"Nuka"sv, "Cola"sv, "Quantum"sv, "Diamond"sv, "City"sv, "Sanctuary"sv, "Concord"sv, "Lexington"sv,
+				"Terminal"sv, "Holotape"sv, "Note"sv, "Door"sv, "Container"sv, "Ammo"sv, "Caps"sv, "Junk"sv,
+				"Steel"sv, "Copper"sv, "Circuitry"sv, "Adhesive"sv, "Light"sv, "Static"sv, "Marker"sv, "Trigger"sv,
+				"Quest"sv, "Scene"sv, "Dialogue"sv, "Topic"sv, "Package"sv, "Idle"sv, "Sandbox"sv, "Patrol"sv
+			};
+			return { WORDS.data(), WORDS.size() };
+		}
+
+		// installs the editor id and created form hooks, then loads every form through them the way the game does
+		static LoadOrder& Generate(const LoadOrderOptions& a_options, bool a_foldCase = true)
+		{
+			static LoadOrder singleton;
+			auto& self = singleton;
+			assert(!self._generated);
+			self._generated = true;
+			self._rng.seed(a_options.seed);
+
+			self.makeFunctions(a_options);
+			FunctionIndex::get().build();
+
+			EditorIDCache::get().install(a_foldCase);
+			CreatedForms::get().install();
+			self.makePlugins(a_options);
+			self.makeForms(a_options);
+			self.makeCreated(a_options);
+			self.makeGlobals(a_options);
+			self.makeSettings(a_options);
+			EditorIDCache::get().sync();
+			return self;
+		}
+
+		[[nodiscard]] std::span<const Generated> forms() const noexcept { return { _forms.data(), _forms.size() }; }
+		[[nodiscard]] std::span<const std::uint32_t> created() const noexcept { return { _created.data(), _created.size() }; }
+
+		// a random editor id which exists, for exact lookups
+		[[nodiscard]] std::string_view sampleEditorID()
+		{
+			for (;;) {
+				const auto& form = _forms[std::uniform_int_distribution<std::size_t>{ 0, _forms.size() - 1 }(_rng)];
+				if (!form.editorID.empty()) {
+					return form.editorID;
+				}
+			}
+		}
+
+		// destroys some of the created forms and creates as many new ones, the way they churn during play
+		void churn(std::size_t a_count)
+		{
+			for (std::size_t i = 0; i < a_count && !_created.empty(); ++i) {
+				const auto pos = std::uniform_int_distribution<std::size_t>{ 0, _created.size() - 1 }(_rng);
+				mock::RemoveForm(_created[pos]);
+				_created[pos] = makeCreated();
+			}
+		}
+
+	private:
+		struct Type
+		{
+		public:
+			RE::ENUM_FORM_ID type;
+			std::size_t weight;  // per mille of the plugin forms
+			double editorIDs;    // the chance a form of the type has an editor id
+			bool named;
+		};
+
+		static constexpr std::array TYPES{
+			Type{ RE::ENUM_FORM_ID::kREFR, 520, 0.05, false },
+			Type{ RE::ENUM_FORM_ID::kACHR, 30, 0.10, false },
+			Type{ RE::ENUM_FORM_ID::kNAVM, 40, 0.00, false },
+			Type{ RE::ENUM_FORM_ID::kCELL, 20, 0.95, true },
+			Type{ RE::ENUM_FORM_ID::kSTAT, 80, 1.00, false },
+			Type{ RE::ENUM_FORM_ID::kINFO, 70, 0.05, false },
+			Type{ RE::ENUM_FORM_ID::kDIAL, 15, 0.90, false },
+			Type{ RE::ENUM_FORM_ID::kQUST, 5, 1.00, true },
+			Type{ RE::ENUM_FORM_ID::kNPC_, 25, 1.00, true },
+			Type{ RE::ENUM_FORM_ID::kWEAP, 10, 1.00, true },
+			Type{ RE::ENUM_FORM_ID::kARMO, 15, 1.00, true },
+			Type{ RE::ENUM_FORM_ID::kMISC, 20, 1.00, true },
+			Type{ RE::ENUM_FORM_ID::kALCH, 8, 1.00, true },
+			Type{ RE::ENUM_FORM_ID::kBOOK, 6, 1.00, true },
+			Type{ RE::ENUM_FORM_ID::kAMMO, 2, 1.00, true },
+			Type{ RE::ENUM_FORM_ID::kCONT, 12, 1.00, true },
+			Type{ RE::ENUM_FORM_ID::kDOOR, 8, 1.00, true },
+			Type{ RE::ENUM_FORM_ID::kACTI, 20, 1.00, true },
+			Type{ RE::ENUM_FORM_ID::kFURN, 10, 1.00, true },
+			Type{ RE::ENUM_FORM_ID::kTERM, 4, 1.00, true },
+			Type{ RE::ENUM_FORM_ID::kLVLI, 18, 1.00, false },
+			Type{ RE::ENUM_FORM_ID::kLVLN, 6, 1.00, false },
+			Type{ RE::ENUM_FORM_ID::kKYWD, 10, 1.00, false },
+			Type{ RE::ENUM_FORM_ID::kCOBJ, 12, 1.00, false },
+			Type{ RE::ENUM_FORM_ID::kOMOD, 14, 1.00, true },
+		};
+
+		LoadOrder() = default;
+
+		~LoadOrder() = default;
+
+		[[nodiscard]] bool chance(double a_probability) { return std::bernoulli_distribution{ a_probability }(_rng); }
+
+		[[nodiscard]] std::string_view word() { return Words()[std::uniform_int_distribution<std::size_t>{ 0, Words().size() - 1 }(_rng)]; }
+
+		[[nodiscard]] std::string phrase(std::size_t a_min, std::size_t a_max, std::string_view a_separator)
+		{
+			std::string result;
+			const auto count = std::uniform_int_distribution<std::size_t>{ a_min, a_max }(_rng);
+			for (std::size_t i = 0; i < count; ++i) {
+				if (i != 0) {
+					result += a_separator;
+				}
+				result += word();
+			}
+			return result;
+		}
+
+		// forms of the hooked classes go through their own vtables, everything else through the base class
+		[[nodiscard]] static std::unique_ptr<RE::TESForm> MakeForm(std::uint32_t a_formID, RE::ENUM_FORM_ID a_type, RE::TESFile* a_file)
+		{
+			using enum RE::ENUM_FORM_ID;
+			switch (a_type) {
+			case kREFR:
+				return std::make_unique<RE::TESObjectREFR>(a_formID, a_type, a_file);
+			case kACHR:
+				return std::make_unique<RE::Actor>(a_formID, a_type, a_file);
+			case kNPC_:
+				return std::make_unique<RE::TESNPC>(a_formID, a_type, a_file);
+			case kWEAP:
+				return std::make_unique<RE::TESObjectWEAP>(a_formID, a_type, a_file);
+			case kARMO:
+				return std::make_unique<RE::TESObjectARMO>(a_formID, a_type, a_file);
+			case kMISC:
+				return std::make_unique<RE::TESObjectMISC>(a_formID, a_type, a_file);
+			case kSTAT:
+				return std::make_unique<RE::TESObjectSTAT>(a_formID, a_type, a_file);
+			case kCELL:
+				return std::make_unique<RE::TESObjectCELL>(a_formID, a_type, a_file);
+			case kLVLI:
+				return std::make_unique<RE::TESLevItem>(a_formID, a_type, a_file);
+			case kOMOD:
+				return std::make_unique<RE::BGSMod::Attachment::Mod>(a_formID, a_type, a_file);
+			case kGLOB:
+				return std::make_unique<RE::TESGlobal>(a_formID, a_file);
+			default:
+				return std::make_unique<RE::TESForm>(a_formID, a_type, a_file);
+			}
+		}
+
+		void makeFunctions(const LoadOrderOptions& a_options)
+		{
+			const auto make = [&](std::vector<RE::SCRIPT_FUNCTION>& a_table, std::size_t a_count) {
+				a_table.clear();
+				a_table.reserve(a_count);
+				for (std::size_t i = 0; i < a_count; ++i) {
+					auto& function = a_table.emplace_back();
+					function.functionName = _strings.emplace_back(i == 0 && std::addressof(a_table) == std::addressof(mock::ConsoleFunctions()) ? "Help"s : phrase(2, 3, ""sv)).c_str();
+					if (chance(0.4)) {
+						function.shortName = _strings.emplace_back(phrase(1, 1, ""sv).substr(0, 3)).c_str();
+					}
+					if (chance(0.7)) {
+						function.helpString = _strings.emplace_back(phrase(3, 6, " "sv)).c_str();
+					}
+				}
+			};
+
+			make(mock::ConsoleFunctions(), a_options.consoleFunctions);
+			make(mock::ScriptFunctions(), a_options.scriptFunctions);
+		}
+
+		void makePlugins(const LoadOrderOptions& a_options)
+		{
+			auto& files = RE::TESDataHandler::GetSingleton()->compiledFileCollection;
+			for (std::size_t i = 0; i < a_options.plugins; ++i) {
+				auto& file = _files.emplace_back(std::make_unique<RE::TESFile>(
+					i == 0 ? "Fallout4.esm"s : fmt::format(FMT_STRING("{}{:03}.esp"), word(), i)));
+				// light plugins live in their own list and share the 0xFE index
+				(i < 0xFD ? files.files : files.smallFiles).push_back(file.get());
+			}
+		}
+
+		void makeForms(const LoadOrderOptions& a_options)
+		{
+			std::vector<std::size_t> weights;
+			for (const auto& type : TYPES) {
+				weights.push_back(type.weight);
+			}
+			std::discrete_distribution<std::size_t> pickType{ weights.begin(), weights.end() };
+
+			// the base game owns a large share of the forms, and the rest are spread over the plugins
+			std::vector<std::uint32_t> nextID(a_options.plugins, 0x800);
+			_forms.reserve(a_options.forms);
+			for (std::size_t i = 0; i < a_options.forms; ++i) {
+				const auto plugin = chance(0.5) ? 0 : std::uniform_int_distribution<std::size_t>{ 0, a_options.plugins - 1 }(_rng);
+				const auto index = plugin < 0xFD ?
+                                       static_cast<std::uint32_t>(plugin) << 24 :
+                                       0xFE000000 | static_cast<std::uint32_t>(plugin - 0xFD) << 12;
+				const auto formID = index | (nextID[plugin]++ & (plugin < 0xFD ? 0xFFFFFF : 0xFFF));
+
+				const auto& type = TYPES[pickType(_rng)];
+				auto form = MakeForm(formID, type.type, _files[plugin].get());
+				if (type.named) {
+					form->fullName = phrase(1, 3, " "sv);
+				} else if (type.type == RE::ENUM_FORM_ID::kLVLI && chance(0.3)) {
+					form->leveledList = std::make_unique<RE::TESLeveledList>();
+					form->leveledList->overrideName = phrase(1, 2, " "sv);
+				}
+
+				auto& generated = _forms.emplace_back(Generated{ formID });
+				if (chance(type.editorIDs)) {
+					generated.editorID = fmt::format(
+						FMT_STRING("{}{}{:02}"),
+						plugin == 0 ? ""sv : _files[plugin]->GetFilename().substr(0, 3),
+						phrase(2, 4, ""sv),
+						i % 100);
+				}
+
+				auto& added = mock::AddForm(std::move(form));
+				if (!generated.editorID.empty()) {
+					added.SetFormEditorID(generated.editorID.c_str());
+				}
+			}
+		}
+
+		[[nodiscard]] std::uint32_t makeCreated()
+		{
+			static constexpr std::array CREATED{ RE::ENUM_FORM_ID::kREFR, RE::ENUM_FORM_ID::kPGRE, RE::ENUM_FORM_ID::kPMIS, RE::ENUM_FORM_ID::kACHR };
+			const auto formID = 0xFF000000 | _nextCreated++;
+			const auto type = CREATED[std::uniform_int_distribution<std::size_t>{ 0, CREATED.size() - 1 }(_rng)];
+			auto form = MakeForm(formID, type, nullptr);
+			if (chance(0.3)) {
+				form->fullName = phrase(1, 2, " "sv);
+			}
+			mock::AddForm(std::move(form));
+			return formID;
+		}
+
+		void makeCreated(const LoadOrderOptions& a_options)
+		{
+			_created.reserve(a_options.created);
+			for (std::size_t i = 0; i < a_options.created; ++i) {
+				_created.push_back(makeCreated());
+			}
+		}
+
+		void makeGlobals(const LoadOrderOptions& a_options)
+		{
+			auto& globals = RE::TESDataHandler::GetSingleton()->GetFormArray<RE::TESGlobal>();
+			for (std::size_t i = 0; i < a_options.globals; ++i) {
+				const auto formID = 0x00F00000 | static_cast<std::uint32_t>(i);
+				auto global = std::make_unique<RE::TESGlobal>(formID, _files.front().get());
+				global->value = static_cast<float>(i) * 0.5F;
+				auto& added = static_cast<RE::TESGlobal&>(mock::AddForm(std::move(global)));
+				const auto& generated = _forms.emplace_back(Generated{ formID, fmt::format(FMT_STRING("{}Global{}"), phrase(1, 3, ""sv), i) });
+				added.SetFormEditorID(generated.editorID.c_str());
+				globals.push_back(std::addressof(added));
+			}
+		}
+
+		void makeSettings(const LoadOrderOptions& a_options)
+		{
+			static constexpr std::array SECTIONS{ "General"sv, "Display"sv, "Interface"sv, "Audio"sv, "Controls"sv, "Gameplay"sv };
+
+			const auto value = [&](char a_prefix) -> RE::Setting::value_type {
+				switch (a_prefix) {
+				case 'b':
+					return chance(0.5);
+				case 'i':
+					return static_cast<std::int32_t>(_rng() % 1000);
+				case 'u':
+					return static_cast<std::uint32_t>(_rng() % 1000);
+				case 'f':
+					return static_cast<float>(_rng() % 1000) / 8.0F;
+				case 's':
+					return phrase(1, 2, " "sv);
+				default:
+					return std::array<std::uint8_t, 3>{ 0x10, 0x20, 0x30 };
+				}
+			};
+			static constexpr auto PREFIXES = "biufsr"sv;
+			const auto prefix = [&]() {
+				return PREFIXES[std::uniform_int_distribution<std::size_t>{ 0, PREFIXES.size() - 1 }(_rng)];
+			};
+
+			const auto inis = stl::make_array(RE::INISettingCollection::GetSingleton(), RE::INIPrefSettingCollection::GetSingleton());
+			for (std::size_t i = 0; i < a_options.settings; ++i) {
+				const auto ch = prefix();
+				const auto section = SECTIONS[i % SECTIONS.size()];
+				auto& setting = _settings.emplace_back(std::make_unique<RE::Setting>(
+					fmt::format(FMT_STRING("{}{}{}:{}"), ch, phrase(1, 3, ""sv), i, section),
+					value(ch)));
+				inis[i % 3 == 0 ? 1 : 0]->settings.push_back(setting.get());
+			}
+
+			auto& gmst = RE::GameSettingCollection::GetSingleton()->settings;
+			for (std::size_t i = 0; i < a_options.gameSettings; ++i) {
+				const auto ch = prefix();
+				auto& setting = _settings.emplace_back(std::make_unique<RE::Setting>(
+					fmt::format(FMT_STRING("{}{}{}"), ch, phrase(1, 3, ""sv), i),
+					value(ch)));
+				gmst.insert_or_assign(setting->GetKey(), setting.get());
+			}
+		}
+
+		std::mt19937_64 _rng;
+		bool _generated{ false };
+		std::uint32_t _nextCreated{ 0 };
+		std::deque<std::string> _strings;  // function names, which the tables point into
+		std::vector<std::unique_ptr<RE::TESFile>> _files;
+		std::vector<std::unique_ptr<RE::Setting>> _settings;
+		std::vector<Generated> _forms;
+		std::vector<std::uint32_t> _created;
+	};
+}
@@ -0,0 +1,93 @@
+#include "Bench.h"
+
+#include "Pattern.h"
+
+// which patterns compile, and what the ones that do match
+// escapes only apply to metacharacters, so shorthand classes and backreferences from other dialects are rejected
+// rather than silently matching a letter or digit, and braces are counted repetition rather than literals
+
+namespace
+{
+	void Matches(std::string_view a_source, Pattern::Syntax a_syntax, std::initializer_list<std::string_view> a_yes, std::initializer_list<std::string_view> a_no)
+	{
+		const auto pattern = Pattern::compile(a_source, a_syntax);
+		if (!bench::Check(pattern.has_value(), fmt::format(FMT_STRING("{} compiles"), a_source))) {
+			return;
+		}
+
+		for (const auto haystack : a_yes) {
+			bench::Check((*pattern)(haystack), fmt::format(FMT_STRING("{} matches {}"), a_source, haystack));
+		}
+		for (const auto haystack : a_no) {
+			bench::Check(!(*pattern)(haystack), fmt::format(FMT_STRING("{} doesn't match {}"), a_source, haystack));
+		}
+	}
+
+	void Regex(std::string_view a_source, std::initializer_list<std::string_view> a_yes, std::initializer_list<std::string_view> a_no)
+	{
+		Matches(a_source, Pattern::Syntax::kRegex, a_yes, a_no);
+	}
+
+	void Rejects(std::string_view a_source)
+	{
+		bench::Check(!Pattern::compile(a_source, Pattern::Syntax::kRegex), fmt::format(FMT_STRING("{} is rejected"), a_source));
+	}
+}
+
+int main()
+{
+	spdlog::set_level(spdlog::level::warn);
+
+	Regex("laser.*"sv, { "LaserRifle"sv, "laser"sv }, { "PlasmaLaser"sv });
+	Regex("[a-c]+[0-9]?"sv, { "abc"sv, "CAB7"sv }, { "abcd"sv, "ab12"sv });
+	Regex("[^0-9]+"sv, { "abc"sv }, { "a1"sv });
+	Regex("(laser|plasma)(rifle|pistol)"sv, { "LaserPistol"sv, "plasmarifle"sv }, { "laserplasma"sv });
+
+	// escapes
+	Regex("a\\.b"sv, { "a.b"sv }, { "axb"sv });
+	Regex("\\(\\)\\[\\]\\{\\}\\|\\*\\+\\?\\\\"sv, { "()[]{}|*+?\\"sv }, {});
+	Regex("[\\]\\-x]+"sv, { "]-x"sv }, { "y"sv });
+	Rejects("\\d+"sv);
+	Rejects("(a)\\1"sv);
+	Rejects("\\w"sv);
+	Rejects("[\\d]"sv);
+	Rejects("a\\"sv);
+
+	// counted repetition
+	Regex("a{2}"sv, { "aa"sv, "AA"sv }, { "a"sv, "aaa"sv, "a{2}"sv });
+	Regex("a{2,}"sv, { "aa"sv, "aaaaa"sv }, { "a"sv });
+	Regex("a{1,3}b"sv, { "ab"sv, "aaab"sv }, { "b"sv, "aaaab"sv });
+	Regex("x(ab){0,2}"sv, { "x"sv, "xab"sv, "xabab"sv }, { "xa"sv, "xababab"sv });
+	Regex("(a|bc){2}d"sv, { "aad"sv, "bcad"sv, "bcbcd"sv }, { "ad"sv, "abd"sv });
+	Regex("[0-9]{3}z?"sv, { "123"sv, "007z"sv }, { "12"sv, "1234"sv });
+	Regex("a*{2}"sv, { ""sv, "aaaa"sv }, { "b"sv });
+	Regex("a{0}b"sv, { "b"sv }, { "ab"sv });
+	Regex("a{3}"sv, { "aaa"sv }, { "aa"sv, "aaaa"sv });
+	Regex("x{3}"sv, { "xxx"sv }, { "xx"sv, "xxxx"sv });
+	Regex("[a-z]{3}"sv, { "abc"sv, "XYZ"sv }, { "ab"sv, "abcd"sv, "ab1"sv });
+	Regex("a{5}"sv, { "aaaaa"sv }, { "aaaa"sv, "aaaaaa"sv });
+	Regex("a{6}"sv, { "aaaaaa"sv }, { "aaaaa"sv, "aaaaaaa"sv });
+	Regex("a{9}"sv, { "aaaaaaaaa"sv }, { "aaaaaaaa"sv, "aaaaaaaaaa"sv });
+	Regex("a{1,4}"sv, { "a"sv, "aa"sv, "aaa"sv, "aaaa"sv }, { ""sv, "aaaaa"sv });
+	Regex("(ab){2,4}"sv, { "abab"sv, "ababab"sv, "abababab"sv }, { "ab"sv, "ababa"sv, "ababababab"sv });
+	Regex("a.{9}"sv, { "a123456789"sv }, { "a12345678"sv, "a1234567890"sv });
+	Regex(".{12}"sv, { "123456789012"sv }, { "12345678901"sv, "1234567890123"sv });
+	Regex(".*a.{8}"sv, { "xa12345678"sv, "aaaaaaaaa"sv }, { "a1234567"sv, "xa123456789"sv });
+	Rejects(".*a.{12}"sv);  // needs thousands of dfa states
+	Rejects("{2}"sv);
+	Rejects("a{"sv);
+	Rejects("a{2"sv);
+	Rejects("a{,2}"sv);
+	Rejects("a{3,2}"sv);
+	Rejects("a{x}"sv);
+	Rejects("a{256}"sv);
+	Rejects("a}"sv);
+	Rejects("((((a{255}){255}){255}){255})"sv);
+	Rejects("(.*[a-m].*[n-z]){100}"sv);  // compiles on the console thread, so its cost is capped
+
+	// globs treat every regex metacharacter but * and ? as a literal
+	Matches("*a{2}*"sv, Pattern::Syntax::kGlob, { "xa{2}y"sv }, { "aa"sv });
+	Matches("laser?rifle*"sv, Pattern::Syntax::kGlob, { "Laser_Rifle01"sv }, { "laserrifle"sv });
+
+	return bench::Finish("PatternTest"sv);
+}
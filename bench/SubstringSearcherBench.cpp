@@ -0,0 +1,137 @@
+#include "Bench.h"
+#include "LoadOrder.h"
+
+#include "SubstringSearcher.h"
+
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+
+#include <random>
+
+// the substring matcher against what Help used before it, knuth-morris-pratt over an iterator folding one character at
+// a time, and a plain scalar search, on a corpus of editor id shaped strings
+// every matcher must agree on every haystack, and the folded search is also measured on a corpus folded up front
+
+namespace
+{
+	// the folding iterator Help used to feed knuth-morris-pratt with
+	class cistring_iterator :
+		public boost::iterator_facade<
+			cistring_iterator,
+			char,
+			std::random_access_iterator_tag,
+			char,
+			std::ptrdiff_t>
+	{
+	public:
+		cistring_iterator() noexcept = default;
+
+		cistring_iterator(std::string_view::iterator a_proxy) noexcept :
+			_proxy(a_proxy)
+		{}
+
+	protected:
+		friend class boost::iterator_core_access;
+
+		[[nodiscard]] char dereference() const noexcept { return stl::tolower(*_proxy); }
+		[[nodiscard]] bool equal(const cistring_iterator& a_rhs) const noexcept { return _proxy == a_rhs._proxy; }
+		void increment() noexcept { ++_proxy; }
+		void decrement() noexcept { --_proxy; }
+		void advance(std::ptrdiff_t a_off) noexcept { _proxy += a_off; }
+		[[nodiscard]] std::ptrdiff_t distance_to(const cistring_iterator& a_rhs) const noexcept { return a_rhs._proxy - _proxy; }
+
+	private:
+		std::string_view::iterator _proxy;
+	};
+
+	[[nodiscard]] std::vector<std::string> MakeCorpus(std::size_t a_count)
+	{
+		const auto words = bench::LoadOrder::Words();
+		std::mt19937_64 rng{ 0x5EED };
+		std::vector<std::string> result;
+		result.reserve(a_count);
+		for (std::size_t i = 0; i < a_count; ++i) {
+			std::string editorID;
+			const auto count = std::uniform_int_distribution<std::size_t>{ 1, 5 }(rng);
+			for (std::size_t j = 0; j < count; ++j) {
+				editorID += words[std::uniform_int_distribution<std::size_t>{ 0, words.size() - 1 }(rng)];
+			}
+			if (rng() % 3 == 0) {
+				editorID += fmt::format(FMT_STRING("{:03}"), rng() % 1000);
+			}
+			result.push_back(std::move(editorID));
+		}
+		return result;
+	}
+
+	template <class F>
+	[[nodiscard]] std::pair<bench::Samples, std::size_t> Measure(std::span<const std::string> a_corpus, std::size_t a_iterations, F&& a_match)
+	{
+		std::size_t matches = 0;
+		auto samples = bench::Samples::Measure(a_iterations, [&]() {
+			matches = static_cast<std::size_t>(std::count_if(a_corpus.begin(), a_corpus.end(), [&](const std::string& a_haystack) {
+				return a_match(std::string_view{ a_haystack });
+			}));
+		});
+		return { std::move(samples), matches };
+	}
+}
+
+int main(int a_argc, char* a_argv[])
+{
+	const auto quick = bench::Quick(a_argc, a_argv);
+	spdlog::set_level(spdlog::level::warn);
+
+	const auto corpus = MakeCorpus(quick ? 20'000 : 500'000);
+	auto folded = corpus;
+	for (auto& haystack : folded) {
+		std::transform(haystack.begin(), haystack.end(), haystack.begin(), stl::tolower);
+	}
+	const auto bytes = std::accumulate(corpus.begin(), corpus.end(), std::size_t{ 0 }, [](std::size_t a_sum, const std::string& a_elem) {
+		return a_sum + a_elem.length();
+	});
+
+	constexpr std::array NEEDLES{ "a"sv, "ore"sv, "laser"sv, "deathclaw"sv, "brotherhoodminuteman"sv, "xyzzy"sv };
+	const std::size_t iterations = quick ? 3 : 20;
+	bench::Table table{ { "needle", "matches", "kmp", "scalar", "searcher", "searcher, folded", "speedup" } };
+	for (const auto needle : NEEDLES) {
+		const boost::algorithm::knuth_morris_pratt kmp{ needle.begin(), needle.end() };
+		const auto [kmpSamples, kmpMatches] = Measure(corpus, iterations, [&](std::string_view a_haystack) {
+			const auto [first, last] = kmp(cistring_iterator{ a_haystack.begin() }, cistring_iterator{ a_haystack.end() });
+			return first != last || needle.empty();
+		});
+
+		const auto [scalarSamples, scalarMatches] = Measure(corpus, iterations, [&](std::string_view a_haystack) {
+			return std::search(
+					   a_haystack.begin(),
+					   a_haystack.end(),
+					   needle.begin(),
+					   needle.end(),
+					   [](char a_lhs, char a_rhs) noexcept { return stl::tolower(a_lhs) == a_rhs; }) != a_haystack.end();
+		});
+
+		const SubstringSearcher searcher{ needle };
+		const auto [searcherSamples, searcherMatches] = Measure(corpus, iterations, searcher);
+		const auto [foldedSamples, foldedMatches] = Measure(folded, iterations, [&](std::string_view a_haystack) {
+			return searcher.folded(a_haystack);
+		});
+
+		bench::Check(scalarMatches == kmpMatches && searcherMatches == kmpMatches && foldedMatches == kmpMatches, "every matcher agrees");
+
+		const auto rate = [&](const bench::Samples& a_samples) {
+			return bench::FormatRate(static_cast<double>(bytes) / a_samples.median() * 1e9, "B"sv);
+		};
+		table.add({
+			std::string{ needle },
+			fmt::format(FMT_STRING("{}"), kmpMatches),
+			rate(kmpSamples),
+			rate(scalarSamples),
+			rate(searcherSamples),
+			rate(foldedSamples),
+			fmt::format(FMT_STRING("{:.1f}x"), kmpSamples.median() / searcherSamples.median()),
+		});
+	}
+	table.print(fmt::format(FMT_STRING("{} haystacks, {}, median of {} runs"), corpus.size(), bench::FormatBytes(static_cast<double>(bytes)), iterations));
+
+	return bench::Finish("SubstringSearcherBench"sv);
+}
@@ -0,0 +1,133 @@
+#include "Bench.h"
+
+#include "CC/Help.h"
+
+#include <random>
+
+// which match strings split into terms, and what the ones that do match
+// terms are ands of space separated words, | separates alternatives, and a word containing * or ? is a glob
+// the aho-corasick searcher beneath them is checked against a naive search on needles which overlap each other
+
+namespace
+{
+	namespace Help = CC::Help::detail;
+
+	void Terms(std::string_view a_matchstring, std::initializer_list<std::string_view> a_yes, std::initializer_list<std::string_view> a_no)
+	{
+		const auto matcher = Help::MakeMatcher(a_matchstring);
+		if (!bench::Check(matcher.has_value(), fmt::format(FMT_STRING("\"{}\" is valid"), a_matchstring))) {
+			return;
+		}
+
+		for (const auto haystack : a_yes) {
+			bench::Check((*matcher)(haystack), fmt::format(FMT_STRING("\"{}\" matches {}"), a_matchstring, haystack));
+		}
+		for (const auto haystack : a_no) {
+			bench::Check(!(*matcher)(haystack), fmt::format(FMT_STRING("\"{}\" doesn't match {}"), a_matchstring, haystack));
+		}
+	}
+
+	void Rejects(std::string_view a_matchstring)
+	{
+		bench::Check(!Help::MakeMatcher(a_matchstring), fmt::format(FMT_STRING("\"{}\" is rejected"), a_matchstring));
+	}
+
+	// w<first> through w<last - 1>, each a term of its own
+	[[nodiscard]] std::string Words(std::size_t a_first, std::size_t a_last)
+	{
+		std::string result;
+		for (auto i = a_first; i < a_last; ++i) {
+			fmt::format_to(std::back_inserter(result), FMT_STRING("w{} "), i);
+		}
+		return result;
+	}
+
+	[[nodiscard]] MultiSubstringSearcher::mask_type Naive(std::span<const std::string_view> a_needles, std::string_view a_haystack)
+	{
+		std::string folded{ a_haystack };
+		for (auto& ch : folded) {
+			ch = stl::tolower(ch);
+		}
+
+		MultiSubstringSearcher::mask_type found = 0;
+		for (std::size_t i = 0; i < a_needles.size(); ++i) {
+			if (std::string_view{ folded }.find(a_needles[i]) != std::string_view::npos) {
+				found |= MultiSubstringSearcher::mask_type{ 1 } << i;
+			}
+		}
+		return found;
+	}
+
+	// needles which are prefixes, suffixes and infixes of each other, so failure links and inherited outputs are all exercised
+	void Searcher()
+	{
+		constexpr std::array needles{ "a"sv, "aa"sv, "aab"sv, "ab"sv, "aba"sv, "abab"sv, "b"sv, "ba"sv, "bab"sv, "bb"sv, "abba"sv, "c"sv };
+		const MultiSubstringSearcher searcher{ std::span{ needles.data(), needles.size() } };
+		const auto all = [](MultiSubstringSearcher::mask_type) noexcept { return false; };
+
+		std::mt19937 rng{ 0x5EED };
+		std::uniform_int_distribution<std::size_t> length{ 0, 12 };
+		constexpr auto alphabet = "abABx"sv;
+		std::uniform_int_distribution<std::size_t> pick{ 0, alphabet.length() - 1 };
+
+		std::size_t mismatches = 0;
+		for (std::size_t i = 0; i < 0x4000; ++i) {
+			std::string haystack(length(rng), '\0');
+			for (auto& ch : haystack) {
+				ch = alphabet[pick(rng)];
+			}
+			if (searcher(haystack, all) != Naive(needles, haystack)) {
+				++mismatches;
+			}
+		}
+		bench::Check(mismatches == 0, "the searcher finds exactly the needles a naive search does");
+
+		const auto stopped = searcher("xxabab"sv, [](MultiSubstringSearcher::mask_type a_found) noexcept { return (a_found & 0b100000) != 0; });
+		bench::Check((stopped & 0b100000) != 0, "the search stops once the callback is satisfied");
+
+		bench::Check(MultiSubstringSearcher{}("ab"sv, all) == 0, "an empty searcher finds nothing");
+	}
+}
+
+int main()
+{
+	spdlog::set_level(spdlog::level::warn);
+
+	// and
+	Terms("laser rifle"sv, { "LaserRifle"sv, "rifle_laser"sv }, { "LaserPistol"sv, "rifle"sv });
+	Terms("  laser \t rifle  "sv, { "LaserRifle"sv }, { "Laser"sv });
+	Terms("a aa aaa"sv, { "aaa"sv }, { "aa"sv });
+	Terms("ab ba"sv, { "aba"sv, "abba"sv }, { "ab"sv, "aab"sv });
+
+	// or
+	Terms("laser | plasma"sv, { "LaserRifle"sv, "PlasmaRifle"sv }, { "Pipe"sv });
+	Terms("laser rifle | plasma pistol"sv, { "LaserRifle"sv, "PlasmaPistol"sv }, { "LaserPistol"sv, "PlasmaRifle"sv });
+	Terms("x | x y"sv, { "x"sv }, { "y"sv });
+
+	// globs beside plain terms, which match the whole haystack rather than a substring of it
+	Terms("rifle las*r*"sv, { "LaserRifle"sv, "LasrRifle"sv }, { "Rifle"sv, "RifleLaser"sv, "Laser"sv });
+	Terms("rifle | *pist?l"sv, { "Rifle"sv, "10mmPistol"sv }, { "pistl"sv, "Pistols"sv });
+	Terms("*rifle* las* | pipe"sv, { "LaserRifle"sv, "PipeGun"sv }, { "Rifle"sv, "Laser"sv });
+	Terms("las?r"sv, { "laser"sv, "LASER"sv }, { "LaserRifle"sv });
+
+	// empty groups
+	Rejects("|"sv);
+	Rejects("a |"sv);
+	Rejects("a | "sv);
+	Rejects("| a"sv);
+	Rejects("a | | b"sv);
+
+	// the plain terms of every group share one searcher, which has a needle per bit
+	// repeated terms share a needle, even across groups
+	constexpr auto max = MultiSubstringSearcher::MAX_NEEDLES;
+	const auto all = Words(0, max);
+	Terms(all, { all }, { "w0 w1"sv });
+	Terms(all + "w0 w1", { all }, {});
+	Terms(Words(0, max / 2 + 1) + "| " + Words(max / 2, max), { Words(0, max / 2 + 1), Words(max / 2, max) }, { "w0"sv });
+	Rejects(Words(0, max + 1));
+	Rejects(Words(0, max / 2 + 1) + "| " + Words(max / 2, max + 1));
+
+	Searcher();
+
+	return bench::Finish("TermsTest"sv);
+}
@@ -0,0 +1,117 @@
+#include "Bench.h"
+#include "LoadOrder.h"
+
+#include "SubstringSearcher.h"
+
+// searching every editor id on a synthetic load order, by scanning all of them against pruning them with the cache's
+// trigram index and only verifying the survivors
+// needles range from ones shorter than a trigram, which can't be pruned, to ones which match nothing at all
+
+namespace
+{
+	struct Needle
+	{
+	public:
+		std::string_view label;
+		std::string_view needle;
+	};
+
+	struct Result
+	{
+	public:
+		bench::Samples samples;
+		std::size_t candidates{ 0 };
+		std::size_t matches{ 0 };
+	};
+
+	[[nodiscard]] Result Scan(std::span<const std::pair<std::uint32_t, std::string_view>> a_editorIDs, const SubstringSearcher& a_searcher, std::size_t a_iterations)
+	{
+		Result result;
+		result.candidates = a_editorIDs.size();
+		result.samples = bench::Samples::Measure(a_iterations, [&]() {
+			result.matches = static_cast<std::size_t>(std::count_if(a_editorIDs.begin(), a_editorIDs.end(), [&](auto&& a_elem) {
+				return a_searcher.folded(a_elem.second);
+			}));
+		});
+		return result;
+	}
+
+	[[nodiscard]] std::optional<Result> Pruned(const EditorIDCache::Cache& a_cache, const SubstringSearcher& a_searcher, std::size_t a_iterations)
+	{
+		if (!a_cache.trigrams().find(a_searcher.needle())) {
+			return std::nullopt;
+		}
+
+		Result result;
+		result.samples = bench::Samples::Measure(a_iterations, [&]() {
+			const auto candidates = a_cache.trigrams().find(a_searcher.needle());
+			result.candidates = candidates->size();
+			result.matches = static_cast<std::size_t>(std::count_if(candidates->begin(), candidates->end(), [&](auto a_formID) {
+				return a_searcher.folded(*a_cache.find_folded(a_formID));
+			}));
+		});
+		return result;
+	}
+}
+
+int main(int a_argc, char* a_argv[])
+{
+	const auto quick = bench::Quick(a_argc, a_argv);
+	spdlog::set_level(spdlog::level::warn);
+
+	const auto options = quick ? bench::LoadOrderOptions::Quick() : bench::LoadOrderOptions{};
+	const auto& loadOrder = bench::LoadOrder::Generate(options);
+	const auto cache = EditorIDCache::get().snapshot();
+
+	// the order Help scans forms in doesn't matter for the cost of a full scan
+	std::vector<std::pair<std::uint32_t, std::string_view>> editorIDs;
+	for (const auto& form : loadOrder.forms()) {
+		if (const auto editorID = cache->find_folded(form.formID); editorID) {
+			editorIDs.emplace_back(form.formID, *editorID);
+		}
+	}
+
+	const auto allocations = bench::ProcessAllocations();
+	const auto start = bench::clock_type::now();
+	static_cast<void>(cache->trigrams());
+	const auto elapsed = bench::Elapsed(start);
+	const auto allocated = bench::ProcessAllocations() - allocations;
+	fmt::print(
+		FMT_STRING("indexed {} editor ids in {}, allocating {}\n"),
+		editorIDs.size(),
+		bench::FormatDuration(static_cast<double>(elapsed.count())),
+		bench::FormatBytes(static_cast<double>(allocated.bytes)));
+
+	constexpr std::array NEEDLES{
+		Needle{ "too short to prune"sv, "ca"sv },
+		Needle{ "one common trigram"sv, "cor"sv },
+		Needle{ "common word"sv, "rifle"sv },
+		Needle{ "rare word"sv, "deathclaw"sv },
+		Needle{ "two words"sv, "combatarmor"sv },
+		Needle{ "no match"sv, "xyzzy"sv },
+	};
+
+	const std::size_t iterations = quick ? 3 : 20;
+	bench::Table table{ { "needle", "scan", "scanned", "pruned", "candidates", "matches", "speedup" } };
+	for (const auto& [label, needle] : NEEDLES) {
+		const SubstringSearcher searcher{ needle };
+		const auto scan = Scan(editorIDs, searcher, iterations);
+		const auto pruned = Pruned(*cache, searcher, iterations);
+		if (pruned) {
+			bench::Check(pruned->matches == scan.matches, "pruning never loses a match");
+		}
+
+		table.add({
+			fmt::format(FMT_STRING("{} ({})"), label, needle),
+			bench::FormatDuration(scan.samples.median()),
+			fmt::format(FMT_STRING("{}"), scan.candidates),
+			pruned ? bench::FormatDuration(pruned->samples.median()) : "-"s,
+			pruned ? fmt::format(FMT_STRING("{}"), pruned->candidates) : "-"s,
+			fmt::format(FMT_STRING("{}"), scan.matches),
+			pruned ? fmt::format(FMT_STRING("{:.1f}x"), scan.samples.median() / pruned->samples.median()) : "-"s,
+		});
+	}
+	table.print(fmt::format(FMT_STRING("editor id search, median of {} runs"), iterations));
+
+	return bench::Finish("TrigramIndexBench"sv);
+}
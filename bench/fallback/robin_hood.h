@@ -0,0 +1,20 @@
+#pragma once
+
+// used when robin_hood isn't installed on the host, so the suite still builds
+// the standard containers are node based, so lookups and memory use measured against them run slower and higher than in game
+
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace robin_hood
+{
+	template <class T>
+	using hash = std::hash<T>;
+
+	template <class Key, class T, class Hash = hash<Key>, class KeyEqual = std::equal_to<Key>>
+	using unordered_flat_map = std::unordered_map<Key, T, Hash, KeyEqual>;
+
+	template <class Key, class Hash = hash<Key>, class KeyEqual = std::equal_to<Key>>
+	using unordered_flat_set = std::unordered_set<Key, Hash, KeyEqual>;
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+// a host-side stand-in for the parts of F4SE the plugin's headers use, so they build and run off-game
+// only that surface is modelled, and the hooks a benchmark needs to drive it live in namespace mock
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+namespace mock
+{
+	// where the plugin keeps its log, and its editor id cache next to it
+	inline std::optional<std::filesystem::path> LogDirectory;
+
+	namespace detail
+	{
+		inline std::mutex UITaskLock;
+		inline std::vector<std::function<void()>> UITasks;
+	}
+
+	// the calling thread plays the part of the ui thread, and runs every task posted so far
+	inline std::size_t RunUITasks()
+	{
+		std::vector<std::function<void()>> tasks;
+		{
+			const std::lock_guard l{ detail::UITaskLock };
+			tasks.swap(detail::UITasks);
+		}
+
+		for (auto& task : tasks) {
+			task();
+		}
+		return tasks.size();
+	}
+}
+
+namespace F4SE
+{
+	namespace stl
+	{
+		using zstring = std::string_view;
+
+		template <class Enum>
+		[[nodiscard]] constexpr auto to_underlying(Enum a_val) noexcept
+			-> std::underlying_type_t<Enum>
+		{
+			return static_cast<std::underlying_type_t<Enum>>(a_val);
+		}
+
+		[[noreturn]] inline void report_and_fail(std::string_view a_msg)
+		{
+			std::fprintf(stderr, "%.*s\n", static_cast<int>(a_msg.size()), a_msg.data());
+			std::abort();
+		}
+	}
+
+	namespace log
+	{
+		[[nodiscard]] inline std::optional<std::filesystem::path> log_directory() { return mock::LogDirectory; }
+
+		namespace detail
+		{
+			template <class... Args>
+			void log(spdlog::level::level_enum a_level, std::string_view a_fmt, Args&&... a_args)
+			{
+				const auto logger = spdlog::default_logger_raw();
+				if (logger->should_log(a_level)) {
+					logger->log(a_level, fmt::format(fmt::runtime(a_fmt), std::forward<Args>(a_args)...));
+				}
+			}
+		}
+
+		template <class... Args>
+		void trace(std::string_view a_fmt, Args&&... a_args) { detail::log(spdlog::level::trace, a_fmt, std::forward<Args>(a_args)...); }
+
+		template <class... Args>
+		void debug(std::string_view a_fmt, Args&&... a_args) { detail::log(spdlog::level::debug, a_fmt, std::forward<Args>(a_args)...); }
+
+		template <class... Args>
+		void info(std::string_view a_fmt, Args&&... a_args) { detail::log(spdlog::level::info, a_fmt, std::forward<Args>(a_args)...); }
+
+		template <class... Args>
+		void warn(std::string_view a_fmt, Args&&... a_args) { detail::log(spdlog::level::warn, a_fmt, std::forward<Args>(a_args)...); }
+
+		template <class... Args>
+		void error(std::string_view a_fmt, Args&&... a_args) { detail::log(spdlog::level::err, a_fmt, std::forward<Args>(a_args)...); }
+
+		template <class... Args>
+		void critical(std::string_view a_fmt, Args&&... a_args) { detail::log(spdlog::level::critical, a_fmt, std::forward<Args>(a_args)...); }
+	}
+
+	namespace WinAPI
+	{
+		inline constexpr std::uint32_t PAGE_EXECUTE_READWRITE = 0x40;
+
+		// the stand-in vtables live in ordinary writable memory, so there is nothing to protect
+		inline bool VirtualProtect(void*, std::size_t, std::uint32_t a_newProtect, std::uint32_t* a_oldProtect) noexcept
+		{
+			if (a_oldProtect) {
+				*a_oldProtect = a_newProtect;
+			}
+			return true;
+		}
+	}
+
+	class TaskInterface
+	{
+	public:
+		void AddUITask(std::function<void()> a_task) const
+		{
+			const std::lock_guard l{ mock::detail::UITaskLock };
+			mock::detail::UITasks.push_back(std::move(a_task));
+		}
+	};
+
+	[[nodiscard]] inline const TaskInterface* GetTaskInterface() noexcept
+	{
+		static TaskInterface singleton;
+		return std::addressof(singleton);
+	}
+}
@@ -0,0 +1,957 @@
+#pragma once
+
+// a host-side stand-in for the game types the plugin's headers use
+// forms, settings and function tables are plain containers which a benchmark fills with a synthetic load order, and
+// every vtable is an ordinary array, so the editor id hooks install and run the same way they do in game
+
+#include "F4SE/F4SE.h"
+
+#include <array>
+#include <cstring>
+#include <memory>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+namespace RE
+{
+	class TESForm;
+}
+
+namespace REL
+{
+	class ID
+	{
+	public:
+		constexpr ID() noexcept = default;
+
+		explicit constexpr ID(std::uintptr_t a_address) noexcept :
+			_address(a_address)
+		{}
+
+		[[nodiscard]] constexpr std::uintptr_t address() const noexcept { return _address; }
+
+	private:
+		std::uintptr_t _address{ 0 };
+	};
+
+	namespace detail
+	{
+		template <class>
+		struct member_function_pointer;
+
+		template <class R, class C, class... Args>
+		struct member_function_pointer<R (C::*)(Args...)>
+		{
+			using type = R (*)(C*, Args...);
+		};
+	}
+
+	template <class T>
+	class Relocation
+	{
+	public:
+		Relocation() noexcept = default;
+
+		explicit Relocation(ID a_id) noexcept :
+			_address(a_id.address())
+		{}
+
+		Relocation& operator=(std::uintptr_t a_address) noexcept
+		{
+			_address = a_address;
+			return *this;
+		}
+
+		[[nodiscard]] std::uintptr_t address() const noexcept { return _address; }
+
+		template <class... Args>
+		decltype(auto) operator()(Args&&... a_args) const
+		{
+			if constexpr (std::is_member_function_pointer_v<T>) {
+				return reinterpret_cast<typename detail::member_function_pointer<T>::type>(_address)(std::forward<Args>(a_args)...);
+			} else {
+				return reinterpret_cast<T>(_address)(std::forward<Args>(a_args)...);
+			}
+		}
+
+	private:
+		std::uintptr_t _address{ 0 };
+	};
+}
+
+namespace RE
+{
+	enum class ENUM_FORM_ID : std::uint8_t
+	{
+		kNONE,
+		kTES4,
+		kGRUP,
+		kGMST,
+		kKYWD,
+		kLCRT,
+		kAACT,
+		kTRNS,
+		kCMPO,
+		kTXST,
+		kMICN,
+		kGLOB,
+		kDMGT,
+		kCLAS,
+		kFACT,
+		kHDPT,
+		kEYES,
+		kRACE,
+		kSOUN,
+		kASPC,
+		kSKIL,
+		kMGEF,
+		kSCPT,
+		kLTEX,
+		kENCH,
+		kSPEL,
+		kSCRL,
+		kACTI,
+		kTACT,
+		kARMO,
+		kBOOK,
+		kCONT,
+		kDOOR,
+		kINGR,
+		kLIGH,
+		kMISC,
+		kSTAT,
+		kSCOL,
+		kMSTT,
+		kGRAS,
+		kTREE,
+		kFLOR,
+		kFURN,
+		kWEAP,
+		kAMMO,
+		kNPC_,
+		kLVLN,
+		kKEYM,
+		kALCH,
+		kIDLM,
+		kNOTE,
+		kPROJ,
+		kHAZD,
+		kBNDS,
+		kSLGM,
+		kTERM,
+		kLVLI,
+		kWTHR,
+		kCLMT,
+		kSPGD,
+		kRFCT,
+		kREGN,
+		kNAVI,
+		kCELL,
+		kREFR,
+		kACHR,
+		kPMIS,
+		kPARW,
+		kPGRE,
+		kPBEA,
+		kPFLA,
+		kPCON,
+		kPBAR,
+		kPHZD,
+		kWRLD,
+		kLAND,
+		kNAVM,
+		kTLOD,
+		kDIAL,
+		kINFO,
+		kQUST,
+		kIDLE,
+		kPACK,
+		kCSTY,
+		kLSCR,
+		kLVSP,
+		kANIO,
+		kWATR,
+		kEFSH,
+		kTOFT,
+		kEXPL,
+		kDEBR,
+		kIMGS,
+		kIMAD,
+		kFLST,
+		kPERK,
+		kBPTD,
+		kADDN,
+		kAVIF,
+		kCAMS,
+		kCPTH,
+		kVTYP,
+		kMATT,
+		kIPCT,
+		kIPDS,
+		kARMA,
+		kECZN,
+		kLCTN,
+		kMESG,
+		kRGDL,
+		kDOBJ,
+		kDFOB,
+		kLGTM,
+		kMUSC,
+		kFSTP,
+		kFSTS,
+		kSMBN,
+		kSMQN,
+		kSMEN,
+		kDLBR,
+		kMUST,
+		kDLVW,
+		kWOOP,
+		kSHOU,
+		kEQUP,
+		kRELA,
+		kSCEN,
+		kASTP,
+		kOTFT,
+		kARTO,
+		kMATO,
+		kMOVT,
+		kSNDR,
+		kDUAL,
+		kSNCT,
+		kSOPM,
+		kCOLL,
+		kCLFM,
+		kREVB,
+		kPKIN,
+		kRFGP,
+		kAMDL,
+		kLAYR,
+		kCOBJ,
+		kOMOD,
+		kMSWP,
+		kZOOM,
+		kINNR,
+		kKSSM,
+		kAECH,
+		kSCCO,
+		kAORU,
+		kSCSN,
+		kSTAG,
+		kNOCM,
+		kLENS,
+		kLSPR,
+		kGDRY,
+		kOVIS,
+
+		kTotal
+	};
+
+	template <class Key, class T>
+	class BSTHashMap
+	{
+	public:
+		using map_type = std::unordered_map<Key, T>;
+		using value_type = typename map_type::value_type;
+		using iterator = typename map_type::iterator;
+		using const_iterator = typename map_type::const_iterator;
+
+		[[nodiscard]] iterator begin() noexcept { return _map.begin(); }
+		[[nodiscard]] const_iterator begin() const noexcept { return _map.begin(); }
+		[[nodiscard]] iterator end() noexcept { return _map.end(); }
+		[[nodiscard]] const_iterator end() const noexcept { return _map.end(); }
+
+		[[nodiscard]] iterator find(const Key& a_key) { return _map.find(a_key); }
+		[[nodiscard]] const_iterator find(const Key& a_key) const { return _map.find(a_key); }
+
+		[[nodiscard]] std::uint32_t size() const noexcept { return static_cast<std::uint32_t>(_map.size()); }
+		[[nodiscard]] bool empty() const noexcept { return _map.empty(); }
+
+		void insert_or_assign(const Key& a_key, T a_value) { _map.insert_or_assign(a_key, std::move(a_value)); }
+		void erase(const Key& a_key) { _map.erase(a_key); }
+		void clear() noexcept { _map.clear(); }
+
+	private:
+		map_type _map;
+	};
+
+	template <class T>
+	class BSTArray
+	{
+	public:
+		using value_type = T;
+		using iterator = typename std::vector<T>::iterator;
+		using const_iterator = typename std::vector<T>::const_iterator;
+
+		[[nodiscard]] iterator begin() noexcept { return _data.begin(); }
+		[[nodiscard]] const_iterator begin() const noexcept { return _data.begin(); }
+		[[nodiscard]] iterator end() noexcept { return _data.end(); }
+		[[nodiscard]] const_iterator end() const noexcept { return _data.end(); }
+
+		[[nodiscard]] std::uint32_t size() const noexcept { return static_cast<std::uint32_t>(_data.size()); }
+		[[nodiscard]] T& operator[](std::size_t a_pos) noexcept { return _data[a_pos]; }
+
+		void push_back(T a_value) { _data.push_back(std::move(a_value)); }
+		void clear() noexcept { _data.clear(); }
+
+	private:
+		std::vector<T> _data;
+	};
+
+	class BSReadWriteLock
+	{
+	public:
+		void lock_read() { _lock.lock_shared(); }
+		void unlock_read() { _lock.unlock_shared(); }
+		void lock_write() { _lock.lock(); }
+		void unlock_write() { _lock.unlock(); }
+
+	private:
+		std::shared_mutex _lock;
+	};
+
+	class BSAutoReadLock
+	{
+	public:
+		explicit BSAutoReadLock(BSReadWriteLock& a_lock) :
+			_lock(std::addressof(a_lock))
+		{
+			_lock->lock_read();
+		}
+
+		explicit BSAutoReadLock(BSReadWriteLock* a_lock) :
+			_lock(a_lock)
+		{
+			if (_lock) {
+				_lock->lock_read();
+			}
+		}
+
+		BSAutoReadLock(const BSAutoReadLock&) = delete;
+
+		~BSAutoReadLock()
+		{
+			if (_lock) {
+				_lock->unlock_read();
+			}
+		}
+
+		BSAutoReadLock& operator=(const BSAutoReadLock&) = delete;
+
+	private:
+		BSReadWriteLock* _lock;
+	};
+
+	class TESFile
+	{
+	public:
+		explicit TESFile(std::string a_filename) :
+			_filename(std::move(a_filename))
+		{}
+
+		[[nodiscard]] std::string_view GetFilename() const noexcept { return _filename; }
+
+	private:
+		std::string _filename;
+	};
+
+	class TESLeveledList
+	{
+	public:
+		[[nodiscard]] const char* GetOverrideName() const noexcept { return overrideName.empty() ? nullptr : overrideName.c_str(); }
+
+		std::string overrideName;
+	};
+
+	namespace detail
+	{
+		inline constexpr std::size_t VTABLE_SIZE = 0x48;
+		inline constexpr std::size_t SET_FORM_EDITOR_ID = 0x3B;
+		inline constexpr std::size_t SET_FORM_ID = 0x40;
+
+		// the base implementations, which the hooks chain into
+		inline bool SetFormEditorID(TESForm*, const char*) { return true; }
+		void SetFormID(TESForm* a_form, std::uint32_t a_formID, bool a_updateFile);
+
+		// every form class gets a vtable of its own, the way they do in game
+		template <class T>
+		[[nodiscard]] std::uintptr_t* VTable() noexcept
+		{
+			static auto vtable = []() noexcept {
+				std::array<std::uintptr_t, VTABLE_SIZE> buf{};
+				buf[SET_FORM_EDITOR_ID] = reinterpret_cast<std::uintptr_t>(SetFormEditorID);
+				buf[SET_FORM_ID] = reinterpret_cast<std::uintptr_t>(SetFormID);
+				return buf;
+			}();
+			return vtable.data();
+		}
+	}
+
+	class TESForm
+	{
+	public:
+		static inline const std::array VTABLE{ REL::ID{ reinterpret_cast<std::uintptr_t>(detail::VTable<TESForm>()) } };
+
+		TESForm(std::uint32_t a_formID, ENUM_FORM_ID a_formType, TESFile* a_file = nullptr, std::uintptr_t* a_vtable = detail::VTable<TESForm>()) noexcept :
+			_vtable(a_vtable),
+			_file(a_file),
+			_formID(a_formID),
+			_formType(a_formType)
+		{}
+
+		TESForm(const TESForm&) = delete;
+		TESForm(TESForm&&) = delete;
+
+		virtual ~TESForm() = default;
+
+		TESForm& operator=(const TESForm&) = delete;
+		TESForm& operator=(TESForm&&) = delete;
+
+		[[nodiscard]] static TESForm* GetFormByID(std::uint32_t a_formID);
+		[[nodiscard]] static auto GetAllForms()
+			-> std::pair<BSTHashMap<std::uint32_t, TESForm*>*, std::reference_wrapper<BSReadWriteLock>>;
+
+		[[nodiscard]] std::uint32_t GetFormID() const noexcept { return _formID; }
+		[[nodiscard]] ENUM_FORM_ID GetFormType() const noexcept { return _formType; }
+		[[nodiscard]] TESFile* GetDescriptionOwnerFile() const noexcept { return _file; }
+		[[nodiscard]] bool IsCreated() const noexcept { return (_formID >> 24) == 0xFF; }
+
+		template <class T>
+		[[nodiscard]] T* As() noexcept
+		{
+			if constexpr (std::is_same_v<T, TESLeveledList>) {
+				return leveledList.get();
+			} else {
+				return dynamic_cast<T*>(this);
+			}
+		}
+
+		// virtual in game, dispatched through slot 0x3B of the form's vtable
+		bool SetFormEditorID(const char* a_editorID)
+		{
+			const auto func = reinterpret_cast<bool (*)(TESForm*, const char*)>(_vtable[detail::SET_FORM_EDITOR_ID]);
+			return func(this, a_editorID);
+		}
+
+		// virtual in game, dispatched through slot 0x40 of the form's vtable, and registers the form under its new id
+		void SetFormID(std::uint32_t a_formID, bool a_updateFile)
+		{
+			const auto func = reinterpret_cast<void (*)(TESForm*, std::uint32_t, bool)>(_vtable[detail::SET_FORM_ID]);
+			func(this, a_formID, a_updateFile);
+		}
+
+		std::string fullName;
+		std::unique_ptr<TESLeveledList> leveledList;
+
+	private:
+		friend void detail::SetFormID(TESForm*, std::uint32_t, bool);
+
+		std::uintptr_t* _vtable;
+		TESFile* _file;
+		std::uint32_t _formID;
+		ENUM_FORM_ID _formType;
+	};
+
+	class TESFullName
+	{
+	public:
+		[[nodiscard]] static std::string_view GetFullName(const TESForm& a_form, bool = false) noexcept { return a_form.fullName; }
+	};
+
+#define MOCK_FORM(a_name)                                                                                                           \
+	class a_name :                                                                                                                  \
+		public TESForm                                                                                                              \
+	{                                                                                                                               \
+	public:                                                                                                                         \
+		static inline const std::array VTABLE{ REL::ID{ reinterpret_cast<std::uintptr_t>(detail::VTable<a_name>()) } };            \
+                                                                                                                                    \
+		a_name(std::uint32_t a_formID, ENUM_FORM_ID a_formType, TESFile* a_file = nullptr) noexcept :                               \
+			TESForm(a_formID, a_formType, a_file, detail::VTable<a_name>())                                                         \
+		{}                                                                                                                          \
+	};
+
+	MOCK_FORM(TESObject)
+	MOCK_FORM(TESBoundObject)
+	MOCK_FORM(MagicItem)
+	MOCK_FORM(TESBoundAnimObject)
+	MOCK_FORM(TESActorBase)
+	MOCK_FORM(BGSStoryManagerTreeForm)
+	MOCK_FORM(BGSStoryManagerNodeBase)
+	MOCK_FORM(BGSKeyword)
+	MOCK_FORM(BGSLocationRefType)
+	MOCK_FORM(BGSAction)
+	MOCK_FORM(BGSTransform)
+	MOCK_FORM(BGSComponent)
+	MOCK_FORM(BGSTextureSet)
+	MOCK_FORM(BGSMenuIcon)
+	MOCK_FORM(BGSDamageType)
+	MOCK_FORM(TESClass)
+	MOCK_FORM(TESFaction)
+	MOCK_FORM(BGSHeadPart)
+	MOCK_FORM(TESEyes)
+	MOCK_FORM(TESRace)
+	MOCK_FORM(TESSound)
+	MOCK_FORM(BGSAcousticSpace)
+	MOCK_FORM(EffectSetting)
+	MOCK_FORM(TESLandTexture)
+	MOCK_FORM(EnchantmentItem)
+	MOCK_FORM(SpellItem)
+	MOCK_FORM(ScrollItem)
+	MOCK_FORM(TESObjectACTI)
+	MOCK_FORM(BGSTalkingActivator)
+	MOCK_FORM(TESObjectARMO)
+	MOCK_FORM(TESObjectBOOK)
+	MOCK_FORM(TESObjectCONT)
+	MOCK_FORM(TESObjectDOOR)
+	MOCK_FORM(IngredientItem)
+	MOCK_FORM(TESObjectLIGH)
+	MOCK_FORM(TESObjectMISC)
+	MOCK_FORM(TESObjectSTAT)
+	MOCK_FORM(BGSStaticCollection)
+	MOCK_FORM(BGSMovableStatic)
+	MOCK_FORM(TESGrass)
+	MOCK_FORM(TESObjectTREE)
+	MOCK_FORM(TESFlora)
+	MOCK_FORM(TESFurniture)
+	MOCK_FORM(TESObjectWEAP)
+	MOCK_FORM(TESAmmo)
+	MOCK_FORM(TESNPC)
+	MOCK_FORM(TESLevCharacter)
+	MOCK_FORM(TESKey)
+	MOCK_FORM(AlchemyItem)
+	MOCK_FORM(BGSIdleMarker)
+	MOCK_FORM(BGSNote)
+	MOCK_FORM(BGSProjectile)
+	MOCK_FORM(BGSHazard)
+	MOCK_FORM(BGSBendableSpline)
+	MOCK_FORM(TESSoulGem)
+	MOCK_FORM(BGSTerminal)
+	MOCK_FORM(TESLevItem)
+	MOCK_FORM(TESWeather)
+	MOCK_FORM(TESClimate)
+	MOCK_FORM(BGSShaderParticleGeometryData)
+	MOCK_FORM(BGSReferenceEffect)
+	MOCK_FORM(TESRegion)
+	MOCK_FORM(NavMeshInfoMap)
+	MOCK_FORM(TESObjectCELL)
+	MOCK_FORM(TESObjectREFR)
+	MOCK_FORM(Explosion)
+	MOCK_FORM(Projectile)
+	MOCK_FORM(Actor)
+	MOCK_FORM(PlayerCharacter)
+	MOCK_FORM(MissileProjectile)
+	MOCK_FORM(ArrowProjectile)
+	MOCK_FORM(GrenadeProjectile)
+	MOCK_FORM(BeamProjectile)
+	MOCK_FORM(FlameProjectile)
+	MOCK_FORM(ConeProjectile)
+	MOCK_FORM(BarrierProjectile)
+	MOCK_FORM(Hazard)
+	MOCK_FORM(TESWorldSpace)
+	MOCK_FORM(TESObjectLAND)
+	MOCK_FORM(NavMesh)
+	MOCK_FORM(TESTopic)
+	MOCK_FORM(TESTopicInfo)
+	MOCK_FORM(TESQuest)
+	MOCK_FORM(TESIdleForm)
+	MOCK_FORM(TESPackage)
+	MOCK_FORM(AlarmPackage)
+	MOCK_FORM(DialoguePackage)
+	MOCK_FORM(FleePackage)
+	MOCK_FORM(SpectatorPackage)
+	MOCK_FORM(TrespassPackage)
+	MOCK_FORM(TESCombatStyle)
+	MOCK_FORM(TESLoadScreen)
+	MOCK_FORM(TESLevSpell)
+	MOCK_FORM(TESObjectANIO)
+	MOCK_FORM(TESWaterForm)
+	MOCK_FORM(TESEffectShader)
+	MOCK_FORM(BGSExplosion)
+	MOCK_FORM(BGSDebris)
+	MOCK_FORM(TESImageSpace)
+	MOCK_FORM(TESImageSpaceModifier)
+	MOCK_FORM(BGSListForm)
+	MOCK_FORM(BGSPerk)
+	MOCK_FORM(BGSBodyPartData)
+	MOCK_FORM(BGSAddonNode)
+	MOCK_FORM(ActorValueInfo)
+	MOCK_FORM(BGSCameraShot)
+	MOCK_FORM(BGSCameraPath)
+	MOCK_FORM(BGSVoiceType)
+	MOCK_FORM(BGSMaterialType)
+	MOCK_FORM(BGSImpactData)
+	MOCK_FORM(BGSImpactDataSet)
+	MOCK_FORM(TESObjectARMA)
+	MOCK_FORM(BGSEncounterZone)
+	MOCK_FORM(BGSLocation)
+	MOCK_FORM(BGSMessage)
+	MOCK_FORM(BGSDefaultObjectManager)
+	MOCK_FORM(BGSDefaultObject)
+	MOCK_FORM(BGSLightingTemplate)
+	MOCK_FORM(BGSMusicType)
+	MOCK_FORM(BGSFootstep)
+	MOCK_FORM(BGSFootstepSet)
+	MOCK_FORM(BGSStoryManagerBranchNode)
+	MOCK_FORM(BGSStoryManagerQuestNode)
+	MOCK_FORM(BGSStoryManagerEventNode)
+	MOCK_FORM(BGSDialogueBranch)
+	MOCK_FORM(BGSMusicTrackFormWrapper)
+	MOCK_FORM(TESWordOfPower)
+	MOCK_FORM(TESShout)
+	MOCK_FORM(BGSEquipSlot)
+	MOCK_FORM(BGSRelationship)
+	MOCK_FORM(BGSScene)
+	MOCK_FORM(BGSAssociationType)
+	MOCK_FORM(BGSOutfit)
+	MOCK_FORM(BGSArtObject)
+	MOCK_FORM(BGSMaterialObject)
+	MOCK_FORM(BGSMovementType)
+	MOCK_FORM(BGSSoundDescriptorForm)
+	MOCK_FORM(BGSDualCastData)
+	MOCK_FORM(BGSSoundCategory)
+	MOCK_FORM(BGSSoundOutput)
+	MOCK_FORM(BGSCollisionLayer)
+	MOCK_FORM(BGSColorForm)
+	MOCK_FORM(BGSReverbParameters)
+	MOCK_FORM(BGSPackIn)
+	MOCK_FORM(BGSAimModel)
+	MOCK_FORM(BGSConstructibleObject)
+	MOCK_FORM(BGSMaterialSwap)
+	MOCK_FORM(BGSZoomData)
+	MOCK_FORM(BGSInstanceNamingRules)
+	MOCK_FORM(BGSSoundKeywordMapping)
+	MOCK_FORM(BGSAudioEffectChain)
+	MOCK_FORM(BGSAttractionRule)
+	MOCK_FORM(BGSSoundCategorySnapshot)
+	MOCK_FORM(BGSSoundTagSet)
+	MOCK_FORM(BGSLensFlare)
+	MOCK_FORM(BGSGodRays)
+
+	namespace BGSMod::Attachment
+	{
+		MOCK_FORM(Mod)
+	}
+
+	class TESGlobal :
+		public TESForm
+	{
+	public:
+		static inline const std::array VTABLE{ REL::ID{ reinterpret_cast<std::uintptr_t>(detail::VTable<TESGlobal>()) } };
+
+		TESGlobal(std::uint32_t a_formID, TESFile* a_file = nullptr) noexcept :
+			TESForm(a_formID, ENUM_FORM_ID::kGLOB, a_file, detail::VTable<TESGlobal>())
+		{}
+
+		float value{ 0.0F };
+	};
+
+	class ScriptLocals
+	{};
+
+	class Script;
+
+	enum class SCRIPT_PARAM_TYPE : std::uint32_t
+	{
+		kChar,
+		kInt,
+		kFloat,
+		kInventoryObject,
+		kObjectRef
+	};
+
+	struct SCRIPT_PARAMETER
+	{
+	public:
+		const char* paramName{ nullptr };
+		SCRIPT_PARAM_TYPE paramType{ SCRIPT_PARAM_TYPE::kChar };
+		bool optional{ false };
+	};
+
+	struct SCRIPT_FUNCTION
+	{
+	public:
+		using Execute_t = bool(const SCRIPT_PARAMETER*, const char*, TESObjectREFR*, TESObjectREFR*, Script*, ScriptLocals*, float&, std::uint32_t&);
+
+		SCRIPT_FUNCTION() noexcept = default;
+
+		SCRIPT_FUNCTION(const char* a_functionName, const char* a_shortName, std::uint32_t a_output) noexcept :
+			functionName(a_functionName),
+			shortName(a_shortName),
+			output(a_output)
+		{}
+
+		[[nodiscard]] static std::span<SCRIPT_FUNCTION> GetConsoleFunctions();
+		[[nodiscard]] static std::span<SCRIPT_FUNCTION> GetScriptFunctions();
+
+		const char* functionName{ nullptr };
+		const char* shortName{ nullptr };
+		std::uint32_t output{ 0 };
+		const char* helpString{ nullptr };
+		bool referenceFunction{ false };
+		std::uint16_t paramCount{ 0 };
+		SCRIPT_PARAMETER* parameters{ nullptr };
+		Execute_t* executeFunction{ nullptr };
+	};
+
+	class Script :
+		public TESForm
+	{
+	public:
+		static inline const std::array VTABLE{ REL::ID{ reinterpret_cast<std::uintptr_t>(detail::VTable<Script>()) } };
+
+		Script(std::uint32_t a_formID, TESFile* a_file = nullptr) noexcept :
+			TESForm(a_formID, ENUM_FORM_ID::kSCPT, a_file, detail::VTable<Script>())
+		{}
+
+		// the arguments come from the ones a benchmark passed to mock::SetConsoleArguments, in order
+		// strings are written to char buffers and integers to std::int32_t, and missing arguments are left untouched
+		template <class... Args>
+		static bool ParseParameters(
+			const SCRIPT_PARAMETER*,
+			const char*,
+			std::uint32_t&,
+			TESObjectREFR*,
+			TESObjectREFR*,
+			Script*,
+			ScriptLocals*,
+			Args... a_args);
+	};
+
+	class Setting
+	{
+	public:
+		enum class SETTING_TYPE
+		{
+			kBinary,
+			kChar,
+			kUChar,
+			kInt,
+			kUInt,
+			kFloat,
+			kString,
+			kRGB,
+			kRGBA,
+			kUnknown
+		};
+
+		using value_type = std::variant<bool, char, std::uint8_t, std::int32_t, std::uint32_t, float, std::string, std::array<std::uint8_t, 3>, std::array<std::uint8_t, 4>>;
+
+		Setting(std::string a_key, value_type a_value) :
+			_key(std::move(a_key)),
+			_value(std::move(a_value))
+		{}
+
+		[[nodiscard]] std::string_view GetKey() const noexcept { return _key; }
+		[[nodiscard]] SETTING_TYPE GetType() const noexcept { return static_cast<SETTING_TYPE>(_value.index()); }
+
+		[[nodiscard]] bool GetBinary() const { return std::get<bool>(_value); }
+		[[nodiscard]] char GetChar() const { return std::get<char>(_value); }
+		[[nodiscard]] std::uint8_t GetUChar() const { return std::get<std::uint8_t>(_value); }
+		[[nodiscard]] std::int32_t GetInt() const { return std::get<std::int32_t>(_value); }
+		[[nodiscard]] std::uint32_t GetUInt() const { return std::get<std::uint32_t>(_value); }
+		[[nodiscard]] float GetFloat() const { return std::get<float>(_value); }
+		[[nodiscard]] const char* GetString() const { return std::get<std::string>(_value).c_str(); }
+		[[nodiscard]] std::array<std::uint8_t, 3> GetRGB() const { return std::get<7>(_value); }
+		[[nodiscard]] std::array<std::uint8_t, 4> GetRGBA() const { return std::get<8>(_value); }
+
+	private:
+		std::string _key;
+		value_type _value;
+	};
+
+	class INISettingCollection
+	{
+	public:
+		[[nodiscard]] static INISettingCollection* GetSingleton()
+		{
+			static INISettingCollection singleton;
+			return std::addressof(singleton);
+		}
+
+		std::vector<Setting*> settings;
+	};
+
+	class INIPrefSettingCollection :
+		public INISettingCollection
+	{
+	public:
+		[[nodiscard]] static INIPrefSettingCollection* GetSingleton()
+		{
+			static INIPrefSettingCollection singleton;
+			return std::addressof(singleton);
+		}
+	};
+
+	class GameSettingCollection
+	{
+	public:
+		[[nodiscard]] static GameSettingCollection* GetSingleton()
+		{
+			static GameSettingCollection singleton;
+			return std::addressof(singleton);
+		}
+
+		BSTHashMap<std::string_view, Setting*> settings;
+	};
+
+	class TESDataHandler
+	{
+	public:
+		struct TESFileCollection
+		{
+		public:
+			BSTArray<TESFile*> files;
+			BSTArray<TESFile*> smallFiles;
+		};
+
+		[[nodiscard]] static TESDataHandler* GetSingleton()
+		{
+			static TESDataHandler singleton;
+			return std::addressof(singleton);
+		}
+
+		template <class T>
+		[[nodiscard]] BSTArray<T*>& GetFormArray() noexcept
+		{
+			static_assert(std::is_same_v<T, TESGlobal>, "only globals are modelled");
+			return globals;
+		}
+
+		TESFileCollection compiledFileCollection;
+		BSTArray<TESGlobal*> globals;
+	};
+
+	// counts what reaches the console, since every append to it is expensive in game
+	class ConsoleLog
+	{
+	public:
+		[[nodiscard]] static ConsoleLog* GetSingleton()
+		{
+			static ConsoleLog singleton;
+			return std::addressof(singleton);
+		}
+
+		void AddString(const char* a_string)
+		{
+			const auto length = std::strlen(a_string);
+			++appends;
+			bytes += length;
+			if (keepText) {
+				text.append(a_string, length);
+			}
+		}
+
+		std::size_t appends{ 0 };
+		std::size_t bytes{ 0 };
+		bool keepText{ false };
+		std::string text;
+	};
+}
+
+#undef MOCK_FORM
+
+namespace mock
+{
+	using Argument = std::variant<std::string, std::int32_t>;
+
+	namespace detail
+	{
+		inline RE::BSTHashMap<std::uint32_t, RE::TESForm*> AllForms;
+		inline RE::BSReadWriteLock AllFormsLock;
+		inline std::unordered_map<std::uint32_t, std::unique_ptr<RE::TESForm>> OwnedForms;
+		inline std::vector<RE::SCRIPT_FUNCTION> ConsoleFunctions;
+		inline std::vector<RE::SCRIPT_FUNCTION> ScriptFunctions;
+		inline std::vector<Argument> ConsoleArguments;
+	}
+
+	// takes ownership of the form, and registers it the way the game does once it's loaded or created
+	inline RE::TESForm& AddForm(std::unique_ptr<RE::TESForm> a_form)
+	{
+		auto& form = *a_form;
+		const auto formID = form.GetFormID();
+		detail::AllFormsLock.lock_write();
+		detail::OwnedForms.insert_or_assign(formID, std::move(a_form));
+		detail::AllFormsLock.unlock_write();
+		form.SetFormID(formID, false);
+		return form;
+	}
+
+	// destroys a form the way the game destroys a created one, while a query may still be running
+	inline void RemoveForm(std::uint32_t a_formID)
+	{
+		std::unique_ptr<RE::TESForm> form;
+		detail::AllFormsLock.lock_write();
+		detail::AllForms.erase(a_formID);
+		if (const auto it = detail::OwnedForms.find(a_formID); it != detail::OwnedForms.end()) {
+			form = std::move(it->second);
+			detail::OwnedForms.erase(it);
+		}
+		detail::AllFormsLock.unlock_write();
+	}
+
+	[[nodiscard]] inline std::vector<RE::SCRIPT_FUNCTION>& ConsoleFunctions() noexcept { return detail::ConsoleFunctions; }
+	[[nodiscard]] inline std::vector<RE::SCRIPT_FUNCTION>& ScriptFunctions() noexcept { return detail::ScriptFunctions; }
+
+	// the arguments the next console command is compiled with
+	inline void SetConsoleArguments(std::vector<Argument> a_arguments) { detail::ConsoleArguments = std::move(a_arguments); }
+}
+
+namespace RE
+{
+	inline void detail::SetFormID(TESForm* a_form, std::uint32_t a_formID, bool)
+	{
+		mock::detail::AllFormsLock.lock_write();
+		a_form->_formID = a_formID;
+		mock::detail::AllForms.insert_or_assign(a_formID, a_form);
+		mock::detail::AllFormsLock.unlock_write();
+	}
+
+	inline TESForm* TESForm::GetFormByID(std::uint32_t a_formID)
+	{
+		BSAutoReadLock l{ mock::detail::AllFormsLock };
+		const auto it = mock::detail::AllForms.find(a_formID);
+		return it != mock::detail::AllForms.end() ? it->second : nullptr;
+	}
+
+	inline auto TESForm::GetAllForms()
+		-> std::pair<BSTHashMap<std::uint32_t, TESForm*>*, std::reference_wrapper<BSReadWriteLock>>
+	{
+		return { std::addressof(mock::detail::AllForms), std::ref(mock::detail::AllFormsLock) };
+	}
+
+	inline std::span<SCRIPT_FUNCTION> SCRIPT_FUNCTION::GetConsoleFunctions() { return mock::detail::ConsoleFunctions; }
+	inline std::span<SCRIPT_FUNCTION> SCRIPT_FUNCTION::GetScriptFunctions() { return mock::detail::ScriptFunctions; }
+
+	template <class... Args>
+	bool Script::ParseParameters(
+		const SCRIPT_PARAMETER*,
+		const char*,
+		std::uint32_t&,
+		TESObjectREFR*,
+		TESObjectREFR*,
+		Script*,
+		ScriptLocals*,
+		Args... a_args)
+	{
+		std::size_t i = 0;
+		const auto parse = [&](auto a_out) {
+			if (i >= mock::detail::ConsoleArguments.size()) {
+				return;
+			}
+
+			const auto& arg = mock::detail::ConsoleArguments[i++];
+			if constexpr (std::is_same_v<decltype(a_out), char*>) {
+				const auto& str = std::get<std::string>(arg);
+				std::memcpy(a_out, str.c_str(), str.length() + 1);
+			} else {
+				*a_out = std::get<std::int32_t>(arg);
+			}
+		};
+		(parse(a_args), ...);
+		return true;
+	}
+}
@@ -5,9 +5,22 @@ set(SOURCES
 	src/CC/Clear.h
 	src/CC/ClearAchievement.h
 	src/CC/CrashToDesktop.h
+	src/CC/DumpMetrics.h
 	src/CC/Help.h
+	src/CreatedForms.h
+	src/DisplayNameCache.h
 	src/EditorIDCache.h
+	src/EditorIDFile.h
+	src/FormHooks.h
 	src/FormTypeMap.h
+	src/FunctionIndex.h
+	src/Metrics.h
+	src/MultiSubstringSearcher.h
 	src/PCH.h
+	src/Pattern.h
+	src/Settings.h
+	src/StringArena.h
+	src/SubstringSearcher.h
+	src/TrigramIndex.h
 	src/main.cpp
 )
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "FunctionIndex.h"
+
 namespace CC::AddAchievement
 {
 	namespace detail
@@ -61,14 +63,8 @@ namespace CC::AddAchievement
 
 	inline void Install()
 	{
-		const auto functions = RE::SCRIPT_FUNCTION::GetScriptFunctions();
-		const auto it = std::find_if(
-			functions.begin(),
-			functions.end(),
-			[&](auto&& a_elem) {
-				return _stricmp(a_elem.functionName, "AddAchievement") == 0;
-			});
-		if (it != functions.end()) {
+		const auto it = FunctionIndex::get().script().find("AddAchievement"sv);
+		if (it) {
 			static std::array params{
 				RE::SCRIPT_PARAMETER{ "Integer", RE::SCRIPT_PARAM_TYPE::kInt, false },
 			};
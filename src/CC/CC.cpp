@@ -4,16 +4,21 @@
 #include "CC/Clear.h"
 #include "CC/ClearAchievement.h"
 #include "CC/CrashToDesktop.h"
+#include "CC/DumpMetrics.h"
 #include "CC/Help.h"
+#include "FunctionIndex.h"
 
 namespace CC
 {
 	void Install()
 	{
+		FunctionIndex::get().build();
+
 		AddAchievement::Install();
 		Clear::Install();
 		ClearAchievement::Install();
 		CrashToDesktop::Install();
+		DumpMetrics::Install();
 		Help::Install();
 
 		logger::debug("installed all console commands"sv);
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "FunctionIndex.h"
+
 namespace CC::Clear
 {
 	namespace detail
@@ -34,14 +36,8 @@ namespace CC::Clear
 
 	inline void Install()
 	{
-		const auto functions = RE::SCRIPT_FUNCTION::GetConsoleFunctions();
-		const auto it = std::find_if(
-			functions.begin(),
-			functions.end(),
-			[&](auto&& a_elem) {
-				return _stricmp(a_elem.functionName, "DumpNiUpdates") == 0;
-			});
-		if (it != functions.end()) {
+		const auto it = FunctionIndex::get().console().find("DumpNiUpdates"sv);
+		if (it) {
 			*it = RE::SCRIPT_FUNCTION{ detail::LONG_NAME.data(), detail::SHORT_NAME.data(), it->output };
 			it->helpString = detail::HelpString().data();
 			it->executeFunction = detail::Execute;
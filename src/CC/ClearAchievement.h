@@ -1,5 +1,7 @@
 #pragma once
 
+#include "FunctionIndex.h"
+
 namespace CC::ClearAchievement
 {
 	namespace detail
@@ -61,14 +63,8 @@ namespace CC::ClearAchievement
 
 	inline void Install()
 	{
-		const auto functions = RE::SCRIPT_FUNCTION::GetConsoleFunctions();
-		const auto it = std::find_if(
-			functions.begin(),
-			functions.end(),
-			[&](auto&& a_elem) {
-				return _stricmp(a_elem.functionName, "ClearAchievement") == 0;
-			});
-		if (it != functions.end()) {
+		const auto it = FunctionIndex::get().console().find("ClearAchievement"sv);
+		if (it) {
 			static std::array params{
 				RE::SCRIPT_PARAMETER{ "Integer", RE::SCRIPT_PARAM_TYPE::kInt, false },
 			};
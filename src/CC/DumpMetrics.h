@@ -0,0 +1,52 @@
+#pragma once
+
+#include "FunctionIndex.h"
+#include "Metrics.h"
+
+namespace CC::DumpMetrics
+{
+	namespace detail
+	{
+		inline constexpr auto LONG_NAME = "DumpMetrics"sv;
+		inline constexpr auto SHORT_NAME = ""sv;
+
+		[[nodiscard]] inline const std::string& HelpString()
+		{
+			static auto help = []() {
+				std::string buf;
+				buf += "\"DumpMetrics\"";
+				return buf;
+			}();
+			return help;
+		}
+
+		inline void Print(stl::zstring a_string)
+		{
+			const auto log = RE::ConsoleLog::GetSingleton();
+			if (log) {
+				log->AddString(a_string.data());
+			}
+		}
+
+		inline bool Execute(const RE::SCRIPT_PARAMETER*, const char*, RE::TESObjectREFR*, RE::TESObjectREFR*, RE::Script*, RE::ScriptLocals*, float&, std::uint32_t&)
+		{
+			const auto metrics = Metrics::get().format();
+			Print(!metrics.empty() ? metrics : "No metrics have been recorded\n"s);
+			return true;
+		}
+	}
+
+	inline void Install()
+	{
+		const auto it = FunctionIndex::get().console().find("BetaComment"sv);
+		if (it) {
+			*it = RE::SCRIPT_FUNCTION{ detail::LONG_NAME.data(), detail::SHORT_NAME.data(), it->output };
+			it->helpString = detail::HelpString().data();
+			it->executeFunction = detail::Execute;
+
+			logger::debug("installed {}", detail::LONG_NAME);
+		} else {
+			stl::report_and_fail("failed to find function"sv);
+		}
+	}
+}
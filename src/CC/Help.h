@@ -1,7 +1,16 @@
 #pragma once
 
+#include "CreatedForms.h"
+#include "DisplayNameCache.h"
 #include "EditorIDCache.h"
 #include "FormTypeMap.h"
+#include "FunctionIndex.h"
+#include "Metrics.h"
+#include "MultiSubstringSearcher.h"
+#include "Pattern.h"
+#include "StringArena.h"
+#include "SubstringSearcher.h"
+#include "TrigramIndex.h"
 
 namespace CC::Help
 {
@@ -14,6 +23,7 @@ namespace CC::Help
 			kSettings,
 			kGlobals,
 			kForms,
+			kEditorID,
 
 			kTotal
 		};
@@ -23,15 +33,19 @@ namespace CC::Help
 			static auto help = []() {
 				std::string buf;
 				buf += "\"Help\" <expr>";
-				buf += "\n\t<expr> ::= <empty> | \" \" <matchstring> | \" \" <matchstring> \" \" <filter> | \" \" <matchstring> \" \" <filter> \" \" <form-type>";
-				buf += "\n\t<matchstring> ::= <string> ; The string to filter results with";
+				buf += "\n\t<expr> ::= <empty> | \" \" <matchstring> | \" \" <matchstring> \" \" <filter> | \" \" <matchstring> \" \" <filter> \" \" <form-type> | \" \" <matchstring> \" \" <filter> \" \" <form-type> \" \" <limit> | \" \" <matchstring> \" \" <filter> \" \" <form-type> \" \" <limit> \" \" <page>";
+				buf += "\n\t<matchstring> ::= <string> ; The string to filter results with, a glob if it contains * or ?, or a regular expression matching the whole name if wrapped in /";
+				buf += "\n\t\t; Space separated terms must all match, and | separates alternatives, i.e. \"laser rifle | pistol\"";
 				buf += "\n\t<filter> ::= <integer>";
 				buf += "\n\t\t; 0 - All";
 				buf += "\n\t\t; 1 - Functions";
 				buf += "\n\t\t; 2 - Settings";
 				buf += "\n\t\t; 3 - Globals";
 				buf += "\n\t\t; 4 - Forms";
-				buf += "\n\t<form-type> ::= <string> ; The form type to filter form results with";
+				buf += "\n\t\t; 5 - Editor ID (exact match)";
+				buf += "\n\t<form-type> ::= <string> ; The form type to filter form results with, or \"*\" for any";
+				buf += "\n\t<limit> ::= <integer> ; The maximum number of results to print per section, or 0 for no limit";
+				buf += "\n\t<page> ::= <integer> ; The page of results to print, starting from 1";
 				return buf;
 			}();
 			return help;
@@ -48,11 +62,15 @@ namespace CC::Help
 			-> std::tuple<
 				std::optional<std::string>,
 				std::optional<Filter>,
-				std::optional<std::string>>
+				std::optional<std::string>,
+				std::optional<std::int32_t>,
+				std::optional<std::int32_t>>
 		{
 			std::array<char, 0x200> matchstring{ '\0' };
 			std::int32_t filter = -1;
 			std::array<char, 0x200> formtype{ '\0' };
+			std::int32_t limit = -1;
+			std::int32_t page = -1;
 
 			RE::Script::ParseParameters(
 				a_parameters,
@@ -64,12 +82,16 @@ namespace CC::Help
 				a_scriptLocals,
 				matchstring.data(),
 				std::addressof(filter),
-				formtype.data());
+				formtype.data(),
+				std::addressof(limit),
+				std::addressof(page));
 
 			std::tuple<
 				std::optional<std::string>,
 				std::optional<Filter>,
-				std::optional<std::string>>
+				std::optional<std::string>,
+				std::optional<std::int32_t>,
+				std::optional<std::int32_t>>
 				results;
 
 			if (matchstring[0] != '\0') {
@@ -84,6 +106,14 @@ namespace CC::Help
 				std::get<2>(results) = formtype.data();
 			}
 
+			if (limit != -1) {
+				std::get<3>(results) = limit;
+			}
+
+			if (page != -1) {
+				std::get<4>(results) = page;
+			}
+
 			return results;
 		}
 
@@ -95,369 +125,1538 @@ namespace CC::Help
 			}
 		}
 
-		template <class T, std::size_t N, class UnaryFunctor>
+		using buffer_type = fmt::memory_buffer;
+
+		inline void Append(buffer_type& a_buf, std::string_view a_string)
+		{
+			a_buf.append(a_string.data(), a_string.data() + a_string.size());
+		}
+
+		inline void Append(buffer_type& a_buf, char a_ch)
+		{
+			a_buf.push_back(a_ch);
+		}
+
+		// fixed width, uppercase, and without going through a format string
+		inline void AppendHex(buffer_type& a_buf, std::uint32_t a_value)
+		{
+			constexpr auto DIGITS = "0123456789ABCDEF"sv;
+			std::array<char, 8> hex;
+			for (auto it = hex.rbegin(); it != hex.rend(); ++it, a_value >>= 4) {
+				*it = DIGITS[a_value & 0xF];
+			}
+			a_buf.append(hex.data(), hex.data() + hex.size());
+		}
+
+		// collects whole lines and posts them to the console in large blocks
+		// every append to the console log is expensive, regardless of how much text it carries
+		// queries run off the console thread, so blocks are handed over as ui tasks, and dropped once the query is cancelled
+		class Output
+		{
+		public:
+			static constexpr std::size_t FLUSH_SIZE = 0x10000;
+
+			explicit Output(std::stop_token a_stop) :
+				_stop(std::move(a_stop))
+			{
+				_buf.reserve(FLUSH_SIZE * 2);
+			}
+
+			Output(const Output&) = delete;
+			Output(Output&&) = delete;
+
+			~Output() { flush(); }
+
+			Output& operator=(const Output&) = delete;
+			Output& operator=(Output&&) = delete;
+
+			void append(std::string_view a_string)
+			{
+				Append(_buf, a_string);
+				commit();
+			}
+
+			// for formatters which write into the buffer directly, commit must be called once the line is complete
+			[[nodiscard]] buffer_type& buffer() noexcept { return _buf; }
+
+			void commit()
+			{
+				if (_buf.size() >= FLUSH_SIZE) {
+					flush();
+				}
+			}
+
+			void flush()
+			{
+				if (_buf.size() != 0 && !_stop.stop_requested()) {
+					// the buffer keeps its capacity, so the only allocation is the block handed to the ui thread
+					const auto task = F4SE::GetTaskInterface();
+					task->AddUITask([buf = fmt::to_string(_buf)]() {
+						const Metrics::Timer timer{ Metrics::Metric::kHelpPrint };
+						Print(buf);
+					});
+				}
+				_buf.clear();
+			}
+
+		private:
+			buffer_type _buf;
+			std::stop_token _stop;
+		};
+
+		// haystacks which come pre-folded from a cache are tagged, so the search can skip folding them
+		struct FoldedString
+		{
+		public:
+			std::string_view value;
+		};
+
+		// groups of terms which must all match, any one group of which is enough
+		// the plain terms of every group are found in a single pass over the haystack, and globs only run once the plain terms
+		// beside them have all been found
+		class Terms
+		{
+		public:
+			using mask_type = MultiSubstringSearcher::mask_type;
+
+			struct Group
+			{
+			public:
+				mask_type required{ 0 };  // the plain terms, as needle bits
+				std::vector<std::shared_ptr<const Pattern>> patterns;
+				std::string literal;  // the longest folded string every match of the group contains
+			};
+
+			Terms(std::span<const std::string_view> a_needles, std::vector<Group> a_groups) :
+				_searcher(a_needles),
+				_groups(std::move(a_groups))
+			{
+				for (const auto& group : _groups) {
+					if (group.patterns.empty()) {
+						_plain.push_back(group.required);
+					}
+				}
+			}
+
+			Terms(const Terms&) = delete;
+			Terms(Terms&&) = delete;
+
+			~Terms() = default;
+
+			Terms& operator=(const Terms&) = delete;
+			Terms& operator=(Terms&&) = delete;
+
+			// any match of a single group contains its literal, but alternatives have nothing in common
+			[[nodiscard]] std::string_view literal() const noexcept { return _groups.size() == 1 ? _groups.front().literal : ""sv; }
+
+			[[nodiscard]] std::vector<std::string_view> literals() const
+			{
+				std::vector<std::string_view> result;
+				result.reserve(_groups.size());
+				for (const auto& group : _groups) {
+					result.emplace_back(group.literal);
+				}
+				return result;
+			}
+
+			[[nodiscard]] bool operator()(std::string_view a_haystack) const noexcept
+			{
+				const auto satisfied = [](mask_type a_required, mask_type a_found) noexcept {
+					return (a_required & ~a_found) == 0;
+				};
+
+				const auto found = _searcher(a_haystack, [&](mask_type a_found) noexcept {
+					return std::any_of(_plain.begin(), _plain.end(), [&](mask_type a_required) noexcept {
+						return satisfied(a_required, a_found);
+					});
+				});
+
+				return std::any_of(_groups.begin(), _groups.end(), [&](const Group& a_group) noexcept {
+					return satisfied(a_group.required, found) &&
+					       std::all_of(a_group.patterns.begin(), a_group.patterns.end(), [&](auto&& a_pattern) noexcept {
+							   return (*a_pattern)(a_haystack);
+						   });
+				});
+			}
+
+		private:
+			MultiSubstringSearcher _searcher;
+			std::vector<Group> _groups;
+			std::vector<mask_type> _plain;  // the groups without any globs, which can end the search early
+		};
+
+		// a query's match string, either a plain substring, a compiled glob or regular expression, or several terms
+		class Matcher
+		{
+		public:
+			Matcher() = default;
+
+			explicit Matcher(std::string_view a_needle) :
+				_searcher(a_needle)
+			{}
+
+			explicit Matcher(std::shared_ptr<const Pattern> a_pattern) noexcept :
+				_pattern(std::move(a_pattern))
+			{}
+
+			explicit Matcher(std::shared_ptr<const Terms> a_terms) noexcept :
+				_terms(std::move(a_terms))
+			{}
+
+			[[nodiscard]] bool substring() const noexcept { return !_pattern && !_terms; }
+
+			// a folded string every match must contain, which the trigram indices can prune candidates with
+			[[nodiscard]] std::string_view literal() const noexcept
+			{
+				return _terms   ? _terms->literal() :
+				       _pattern ? _pattern->literal() :
+				                  _searcher.needle();
+			}
+
+			// folded strings every match contains at least one of
+			[[nodiscard]] std::vector<std::string_view> literals() const { return _terms ? _terms->literals() : std::vector{ literal() }; }
+
+			[[nodiscard]] bool operator()(std::string_view a_haystack) const noexcept
+			{
+				return _terms   ? (*_terms)(a_haystack) :
+				       _pattern ? (*_pattern)(a_haystack) :
+				                  _searcher(a_haystack);
+			}
+
+			[[nodiscard]] bool folded(std::string_view a_haystack) const noexcept
+			{
+				return _terms   ? (*_terms)(a_haystack) :
+				       _pattern ? (*_pattern)(a_haystack) :
+				                  _searcher.folded(a_haystack);
+			}
+
+		private:
+			SubstringSearcher _searcher;
+			std::shared_ptr<const Pattern> _pattern;
+			std::shared_ptr<const Terms> _terms;
+		};
+
+		[[nodiscard]] inline bool Search(const Matcher& a_matcher, std::string_view a_haystack) noexcept { return a_matcher(a_haystack); }
+		[[nodiscard]] inline bool Search(const Matcher& a_matcher, FoldedString a_haystack) noexcept { return a_matcher.folded(a_haystack.value); }
+
+		// a window into the sorted results of a section
+		class Page
+		{
+		public:
+			Page() noexcept = default;
+
+			Page(std::size_t a_limit, std::size_t a_index) noexcept :
+				_limit(a_limit),
+				_index(a_index)
+			{}
+
+			[[nodiscard]] bool bounded() const noexcept { return _limit != 0; }
+			[[nodiscard]] std::size_t index() const noexcept { return _index; }
+			[[nodiscard]] std::size_t limit() const noexcept { return _limit; }
+
+			// the number of leading results which must be kept to produce this page
+			[[nodiscard]] std::size_t bound() const noexcept
+			{
+				const auto first = offset();
+				return bounded() && first <= MAX - _limit ? first + _limit : MAX;
+			}
+
+			[[nodiscard]] std::size_t offset() const noexcept
+			{
+				if (!bounded()) {
+					return 0;
+				}
+				return _index <= MAX / _limit ? _index * _limit : MAX;
+			}
+
+		private:
+			static constexpr auto MAX = std::numeric_limits<std::size_t>::max();
+
+			std::size_t _limit{ 0 };
+			std::size_t _index{ 0 };
+		};
+
+		template <class T>
+		struct Matches
+		{
+		public:
+			std::vector<T> items;
+			std::vector<T> all;  // every match in source order, only collected on request
+			std::size_t total{ 0 };
+		};
+
+		// a match paired with the key it sorts by, so ordering never has to chase pointers back into the source
+		template <class K, class V>
+		struct Keyed
+		{
+		public:
+			[[nodiscard]] friend bool operator<(const Keyed& a_lhs, const Keyed& a_rhs) noexcept { return a_lhs.key < a_rhs.key; }
+
+			K key;
+			V value;
+		};
+
+		// the callback is invoked as callback(element, match), where match(haystack) searches a single haystack
+		// callbacks should return as soon as any haystack matches, and only compute the ones they actually search
+		// matches are returned sorted by the key projected from each of them, and clipped to the requested page
+		template <class T, std::size_t N, class BinaryPredicate, class Projection>
 		[[nodiscard]] inline auto Enumerate(
-			std::string_view a_matchstring,
+			const std::stop_token& a_stop,
+			const Matcher& a_matcher,
 			std::span<T, N> a_src,
-			UnaryFunctor a_callback)
+			BinaryPredicate a_callback,
+			Projection a_proj,
+			Page a_page,
+			bool a_collectAll = false)
 		{
-			boost::container::vector<bool> results(a_src.size(), false);
-			const boost::algorithm::knuth_morris_pratt kmp{
-				a_matchstring.begin(),
-				a_matchstring.end()
+			using result_type = std::conditional_t<
+				std::is_pointer_v<T>,
+				std::remove_const_t<T>,
+				T*>;
+			using key_type = std::decay_t<std::invoke_result_t<Projection&, result_type>>;
+			using keyed_type = Keyed<key_type, result_type>;
+
+			struct Chunk
+			{
+			public:
+				std::vector<keyed_type> items;
+				std::vector<result_type> all;
+				std::size_t total{ 0 };
+			};
+
+			// every worker collects the matches of its own chunk, which are then stitched together in order
+			// when paging, each chunk only keeps a bounded max heap of its best matches instead of all of them
+			constexpr std::size_t CHUNK_SIZE = 0x400;
+			constexpr std::size_t PARALLEL_SORT = 0x4000;
+			const auto match = [&](auto&& a_haystack) noexcept {
+				return Search(a_matcher, a_haystack);
 			};
+			const auto bound = a_page.bound();
+			std::vector<Chunk> chunks((a_src.size() + CHUNK_SIZE - 1) / CHUNK_SIZE);
 
-			std::for_each_n(
-				std::execution::parallel_unsequenced_policy{},
-				a_src.begin(),
-				a_src.size(),
-				[&](auto&& a_elem) noexcept {
-					for (const auto& haystack : a_callback(a_elem)) {
-						const auto [first, last] = kmp(
-							stl::cistring_iterator{ haystack.begin() },
-							stl::cistring_iterator{ haystack.end() });
-						if (first != last) {
-							const auto pos = std::addressof(a_elem) - a_src.data();
-							results[pos] = true;
+			{
+				const Metrics::Timer timer{ Metrics::Metric::kHelpMatch };
+				std::for_each(
+					std::execution::par,
+					chunks.begin(),
+					chunks.end(),
+					[&](auto& a_chunk) {
+						if (a_stop.stop_requested()) {
+							return;
 						}
+
+						const auto first = static_cast<std::size_t>(std::addressof(a_chunk) - chunks.data()) * CHUNK_SIZE;
+						const auto last = std::min(first + CHUNK_SIZE, a_src.size());
+						Chunk matched;
+						for (auto i = first; i < last; ++i) {
+							if (a_callback(a_src[i], match)) {
+								result_type value;
+								if constexpr (std::is_pointer_v<T>) {
+									value = a_src[i];
+								} else {
+									value = a_src.data() + i;
+								}
+
+								matched.items.push_back({ a_proj(value), value });
+								if (a_collectAll) {
+									matched.all.push_back(value);
+								}
+
+								++matched.total;
+								if (a_page.bounded()) {
+									std::push_heap(matched.items.begin(), matched.items.end());
+									if (matched.items.size() > bound) {
+										std::pop_heap(matched.items.begin(), matched.items.end());
+										matched.items.pop_back();
+									}
+								}
+							}
+						}
+						a_chunk = std::move(matched);  // one write to the shared array, after all the work is done
+					});
+			}
+
+			const Metrics::Timer timer{ Metrics::Metric::kHelpSort };
+			std::size_t size = 0;
+			for (const auto& chunk : chunks) {
+				size += chunk.items.size();
+			}
+
+			std::vector<keyed_type> items;
+			Matches<result_type> matched;
+			items.reserve(size);
+			if (a_collectAll) {
+				matched.all.reserve(size);
+			}
+			for (const auto& chunk : chunks) {
+				items.insert(items.end(), chunk.items.begin(), chunk.items.end());
+				matched.all.insert(matched.all.end(), chunk.all.begin(), chunk.all.end());
+				matched.total += chunk.total;
+			}
+
+			if (items.size() > bound) {
+				std::nth_element(items.begin(), items.begin() + bound, items.end());
+				items.resize(bound);
+			}
+			if (items.size() >= PARALLEL_SORT) {
+				std::sort(std::execution::par, items.begin(), items.end());
+			} else {
+				std::sort(items.begin(), items.end());
+			}
+
+			const auto offset = std::min(a_page.offset(), items.size());
+			matched.items.reserve(items.size() - offset);
+			for (auto i = offset; i < items.size(); ++i) {
+				matched.items.push_back(items[i].value);
+			}
+
+			return matched;
+		}
+
+		template <class T>
+		inline void PrintPage(Output& a_out, const Matches<T>& a_matches, Page a_page)
+		{
+			if (a_page.bounded()) {
+				const auto pages = std::max<std::size_t>((a_matches.total + a_page.limit() - 1) / a_page.limit(), 1);
+				fmt::format_to(
+					std::back_inserter(a_out.buffer()),
+					FMT_STRING("<page {} of {}, {} matches>\n"),
+					a_page.index() + 1,
+					pages,
+					a_matches.total);
+				a_out.commit();
+			}
+		}
+
+		// forms loaded from plugins live for the whole session, but created forms can be destroyed while a query runs
+		// so everything the query needs from a created form is captured up front, and it's never dereferenced afterwards
+		struct FormRecord
+		{
+		public:
+			[[nodiscard]] static bool IsCreated(std::uint32_t a_formID) noexcept { return (a_formID >> 24) == 0xFF; }
+
+			[[nodiscard]] bool created() const noexcept { return IsCreated(formID); }
+
+			[[nodiscard]] std::string_view displayName(DisplayNameCache::Table& a_names) const
+			{
+				return created() ? name : a_names.resolve(*form);
+			}
+
+			[[nodiscard]] std::string_view filename() const
+			{
+				const auto file = !created() ? form->GetDescriptionOwnerFile() : nullptr;
+				return file ? file->GetFilename() : ""sv;
+			}
+
+			RE::TESForm* form{ nullptr };
+			std::uint32_t formID{ 0 };
+			RE::ENUM_FORM_ID formType{ RE::ENUM_FORM_ID::kNONE };
+			std::string_view name;  // only captured for created forms
+		};
+
+		// forms are ordered by type, then by id
+		[[nodiscard]] inline std::uint64_t FormKey(const FormRecord* a_form) noexcept
+		{
+			return (std::uint64_t{ stl::to_underlying(a_form->formType) } << 32) | a_form->formID;
+		}
+
+		inline void FormatForm(buffer_type& a_buf, const FormRecord& a_form, const EditorIDCache::Cache& a_idCache, DisplayNameCache::Table& a_names)
+		{
+			if (const auto filename = a_form.filename();
+				!filename.empty()) {
+				Append(a_buf, filename);
+				Append(a_buf, ' ');
+			}
+
+			if (const auto typeString = FormTypeMap::find(a_form.formType);
+				typeString) {
+				Append(a_buf, *typeString);
+			}
+
+			Append(a_buf, ':');
+
+			if (const auto editorID = a_idCache.find(a_form.formID);
+				editorID) {
+				Append(a_buf, ' ');
+				Append(a_buf, *editorID);
+			}
+
+			Append(a_buf, " ("sv);
+			AppendHex(a_buf, a_form.formID);
+			Append(a_buf, ')');
+
+			if (const auto displayName = a_form.displayName(a_names);
+				!displayName.empty()) {
+				Append(a_buf, ' ');
+				Append(a_buf, displayName);
+			}
+
+			Append(a_buf, '\n');
+		}
+
+		// display names of forms with editor ids come from plugins, so they only change alongside the cache or the name table
+		// plugin forms live for the whole session, so the index can be built from their ids without holding the all forms lock
+		class DisplayNames
+		{
+		public:
+			[[nodiscard]] const TrigramIndex& trigrams() const noexcept { return _trigrams; }
+
+			void build(const EditorIDCache::Cache& a_idCache, DisplayNameCache::Table& a_names)
+			{
+				_trigrams = {};
+				for (const auto formID : a_idCache.keys()) {
+					if (const auto form = RE::TESForm::GetFormByID(formID);
+						form && !form->IsCreated()) {
+						_trigrams.insert(formID, a_names.resolve(*form));
 					}
-				});
+				}
+				_trigrams.build();
+			}
+
+		private:
+			TrigramIndex _trigrams;
+		};
 
-			std::vector<
-				std::conditional_t<
-					std::is_pointer_v<T>,
-					std::remove_const_t<T>,
-					T*>>
-				matched;
-			matched.reserve(a_src.size());
-			for (std::size_t i = 0; i < results.size(); ++i) {
-				if (results[i]) {
-					if constexpr (std::is_pointer_v<T>) {
-						matched.push_back(a_src[i]);
+		// built by the first query to need it on the worker, which later queries against the same cache and names reuse
+		[[nodiscard]] inline std::shared_ptr<const DisplayNames> GetDisplayNames(
+			const EditorIDCache::Cache& a_idCache,
+			const std::shared_ptr<DisplayNameCache::Table>& a_names)
+		{
+			static std::mutex lock;
+			static std::optional<std::uint64_t> epoch;
+			static std::weak_ptr<DisplayNameCache::Table> table;
+			static std::shared_ptr<const DisplayNames> names;
+
+			const std::lock_guard l{ lock };
+			if (epoch != a_idCache.epoch() || table.lock() != a_names) {
+				auto rebuilt = std::make_shared<DisplayNames>();
+				rebuilt->build(a_idCache, *a_names);
+				names = std::move(rebuilt);
+				epoch = a_idCache.epoch();
+				table = a_names;
+			}
+			return names;
+		}
+
+		class FormSet
+		{
+		public:
+			FormSet() = default;
+			FormSet(const FormSet&) = delete;
+			FormSet(FormSet&&) = delete;
+
+			~FormSet() = default;
+
+			FormSet& operator=(const FormSet&) = delete;
+			FormSet& operator=(FormSet&&) = delete;
+
+			void push_back(RE::TESForm& a_form)
+			{
+				auto& record = records.emplace_back(FormRecord{ std::addressof(a_form), a_form.GetFormID(), a_form.GetFormType() });
+				if (record.created()) {
+					record.name = names.view(names.push_back(DisplayNameCache::Resolve(a_form)));
+				}
+			}
+
+			void push_back(const FormRecord& a_record)
+			{
+				auto& record = records.emplace_back(a_record);
+				if (record.created()) {
+					record.name = names.view(names.push_back(a_record.name));
+				}
+			}
+
+			std::vector<FormRecord> records;
+			StringArena names;
+		};
+
+		// the most recently compiled patterns, so paging through the results of one doesn't compile it again
+		class Patterns
+		{
+		public:
+			static constexpr std::size_t CAPACITY = 0x10;
+
+			Patterns(const Patterns&) = delete;
+			Patterns(Patterns&&) = delete;
+
+			Patterns& operator=(const Patterns&) = delete;
+			Patterns& operator=(Patterns&&) = delete;
+
+			[[nodiscard]] static Patterns& get()
+			{
+				static Patterns singleton;
+				return singleton;
+			}
+
+			// returns nothing if the pattern doesn't compile
+			[[nodiscard]] std::shared_ptr<const Pattern> compile(std::string_view a_source, Pattern::Syntax a_syntax)
+			{
+				const std::lock_guard l{ _lock };
+				const auto it = std::find_if(
+					_recent.begin(),
+					_recent.end(),
+					[&](auto&& a_elem) noexcept {
+						return a_elem.syntax == a_syntax && a_elem.source == a_source;
+					});
+				if (it != _recent.end()) {
+					std::rotate(_recent.begin(), it, it + 1);
+					return _recent.front().pattern;
+				}
+
+				auto compiled = Pattern::compile(a_source, a_syntax);
+				if (!compiled) {
+					return nullptr;
+				}
+
+				auto pattern = std::make_shared<const Pattern>(std::move(*compiled));
+				if (_recent.size() >= CAPACITY) {
+					_recent.pop_back();
+				}
+				_recent.insert(_recent.begin(), Entry{ std::string{ a_source }, a_syntax, pattern });
+				return pattern;
+			}
+
+		private:
+			struct Entry
+			{
+			public:
+				std::string source;
+				Pattern::Syntax syntax{ Pattern::Syntax::kGlob };
+				std::shared_ptr<const Pattern> pattern;
+			};
+
+			Patterns() = default;
+
+			~Patterns() = default;
+
+			mutable std::mutex _lock;
+			std::vector<Entry> _recent;  // most recently used first
+		};
+
+		[[nodiscard]] inline bool IsGlob(std::string_view a_term) noexcept { return a_term.find_first_of("*?"sv) != std::string_view::npos; }
+
+		[[nodiscard]] inline std::shared_ptr<const Terms> MakeTerms(std::span<const std::vector<std::string_view>> a_groups)
+		{
+			std::vector<std::string_view> needles;
+			std::vector<Terms::Group> groups;
+			for (const auto& terms : a_groups) {
+				auto& group = groups.emplace_back();
+				for (const auto term : terms) {
+					std::string_view literal;
+					if (IsGlob(term)) {
+						auto pattern = Patterns::get().compile(term, Pattern::Syntax::kGlob);
+						if (!pattern) {
+							return nullptr;
+						}
+						literal = pattern->literal();
+						group.patterns.push_back(std::move(pattern));
 					} else {
-						matched.push_back(a_src.data() + i);
+						auto it = std::find(needles.begin(), needles.end(), term);
+						if (it == needles.end()) {
+							if (needles.size() >= MultiSubstringSearcher::MAX_NEEDLES) {
+								return nullptr;
+							}
+							it = needles.insert(needles.end(), term);
+						}
+						literal = term;
+						group.required |= Terms::mask_type{ 1 } << (it - needles.begin());
+					}
+
+					if (literal.length() > group.literal.length()) {
+						group.literal = literal;
 					}
 				}
 			}
-			return matched;
+
+			return std::make_shared<const Terms>(std::span{ needles.data(), needles.size() }, std::move(groups));
 		}
 
-		inline void EnumerateForms(std::string_view a_matchstring, std::optional<RE::ENUM_FORM_ID> a_formtype)
+		// a match string wrapped in slashes is a regular expression, otherwise it's split into space separated terms, with |
+		// separating alternatives, where a term containing * or ? is a glob
+		[[nodiscard]] inline std::optional<Matcher> MakeMatcher(std::string_view a_matchstring)
 		{
-			Print("----OTHER FORMS--------------------\n"sv);
-			const auto [allForms, allFormsMapLock] = RE::TESForm::GetAllForms();
-			RE::BSAutoReadLock l{ allFormsMapLock };
-			if (allForms) {
-				std::vector<RE::TESForm*> candidates;
-				std::for_each(
-					allForms->begin(),
-					allForms->end(),
-					[&](auto&& a_elem) {
-						if (const auto form = a_elem.second;
-							form && (!a_formtype || form->GetFormType() == *a_formtype)) {
-							candidates.push_back(form);
-						}
-					});
+			if (a_matchstring.length() >= 2 && a_matchstring.front() == '/' && a_matchstring.back() == '/') {
+				auto pattern = Patterns::get().compile(a_matchstring.substr(1, a_matchstring.length() - 2), Pattern::Syntax::kRegex);
+				return pattern ? std::make_optional(Matcher{ std::move(pattern) }) : std::nullopt;
+			}
+
+			std::vector<std::vector<std::string_view>> groups(1);
+			for (std::size_t pos = 0; pos < a_matchstring.length();) {
+				const auto first = a_matchstring.find_first_not_of(" \t"sv, pos);
+				if (first == std::string_view::npos) {
+					break;
+				}
+				const auto last = std::min(a_matchstring.find_first_of(" \t"sv, first), a_matchstring.length());
+				const auto term = a_matchstring.substr(first, last - first);
+				if (term == "|"sv) {
+					groups.emplace_back();
+				} else {
+					groups.back().push_back(term);
+				}
+				pos = last;
+			}
 
-				const auto getDisplayName = [](RE::TESForm& a_form) {
-					auto displayName = RE::TESFullName::GetFullName(a_form, true);
-					if (displayName.empty()) {
-						const auto lvli = a_form.As<RE::TESLeveledList>();
-						displayName = lvli ? stl::safe_string(lvli->GetOverrideName()) : ""sv;
+			if (groups.size() == 1 && groups.front().size() <= 1) {
+				const auto term = groups.front().empty() ? ""sv : groups.front().front();
+				if (IsGlob(term)) {
+					auto pattern = Patterns::get().compile(term, Pattern::Syntax::kGlob);
+					return pattern ? std::make_optional(Matcher{ std::move(pattern) }) : std::nullopt;
+				} else {
+					return Matcher{ term };
+				}
+			} else if (std::any_of(groups.begin(), groups.end(), [](auto&& a_group) noexcept { return a_group.empty(); })) {
+				return std::nullopt;
+			}
+
+			auto terms = MakeTerms(std::span{ groups.data(), groups.size() });
+			return terms ? std::make_optional(Matcher{ std::move(terms) }) : std::nullopt;
+		}
+
+		// the last match set of every filter and form type
+		// a query whose match string contains the last one can only match a subset of its forms, so it only rechecks those
+		// patterns only reuse substring matches, through the literal every one of their own matches must contain
+		class Refinements
+		{
+		public:
+			using key_type = std::uint32_t;
+
+			struct Entry
+			{
+			public:
+				std::string matchstring;
+				std::uint64_t epoch{ 0 };
+				std::weak_ptr<DisplayNameCache::Table> names;
+				std::shared_ptr<const FormSet> matches;  // only plugin forms
+			};
+
+			Refinements(const Refinements&) = delete;
+			Refinements(Refinements&&) = delete;
+
+			Refinements& operator=(const Refinements&) = delete;
+			Refinements& operator=(Refinements&&) = delete;
+
+			[[nodiscard]] static Refinements& get()
+			{
+				static Refinements singleton;
+				return singleton;
+			}
+
+			[[nodiscard]] static key_type make_key(Filter a_filter, std::optional<RE::ENUM_FORM_ID> a_formtype) noexcept
+			{
+				const auto formtype = a_formtype ? 0x100 | stl::to_underlying(*a_formtype) : 0;
+				return (static_cast<key_type>(a_filter) << 16) | static_cast<key_type>(formtype);
+			}
+
+			// plugin forms only come and go while plugins load, which the cache epoch already guards against
+			// loading a save can rename forms, which replaces the name table, so an entry is tied to the table it matched
+			// created forms churn all session, so they're never kept here and every query gathers them afresh
+			[[nodiscard]] std::shared_ptr<const FormSet> find(
+				key_type a_key,
+				std::string_view a_matchstring,
+				std::uint64_t a_epoch,
+				const std::shared_ptr<DisplayNameCache::Table>& a_names) const
+			{
+				const std::lock_guard l{ _lock };
+				const auto it = _entries.find(a_key);
+				if (it != _entries.end()) {
+					const auto& entry = it->second;
+					if (entry.epoch == a_epoch &&
+						entry.names.lock() == a_names &&
+						a_matchstring.find(entry.matchstring) != std::string_view::npos) {
+						return entry.matches;
 					}
-					return displayName;
-				};
+				}
+				return nullptr;
+			}
 
-				const auto idCache = EditorIDCache::get().access();
-				auto matches = Enumerate(
-					a_matchstring,
-					std::span{ candidates.data(), candidates.size() },
-					[&](auto&& a_form) {
-						boost::container::static_vector<std::string_view, 2> arr;
-						if (const auto editorID = idCache->find(a_form->GetFormID()); editorID) {
-							arr.emplace_back(*editorID);
-						}
-						if (const auto displayName = getDisplayName(*a_form); !displayName.empty()) {
-							arr.push_back(displayName);
+			void insert(key_type a_key, Entry a_entry)
+			{
+				const std::lock_guard l{ _lock };
+				_entries.insert_or_assign(a_key, std::move(a_entry));
+			}
+
+		private:
+			Refinements() = default;
+
+			~Refinements() = default;
+
+			mutable std::mutex _lock;
+			robin_hood::unordered_flat_map<key_type, Entry> _entries;
+		};
+
+		// the leading characters of a name are case folded and packed big endian, so most comparisons are a single integer compare
+		// names which share the whole prefix fall back to comparing the rest of the name
+		struct SettingKey
+		{
+		public:
+			SettingKey() noexcept = default;
+
+			explicit SettingKey(std::string_view a_name) noexcept :
+				name(a_name)
+			{
+				for (std::size_t i = 0; i < sizeof(prefix); ++i) {
+					const auto ch = i < a_name.length() ? static_cast<unsigned char>(stl::tolower(a_name[i])) : 0u;
+					prefix = (prefix << 8) | ch;
+				}
+			}
+
+			[[nodiscard]] friend bool operator<(const SettingKey& a_lhs, const SettingKey& a_rhs) noexcept
+			{
+				return a_lhs.prefix != a_rhs.prefix ?
+                           a_lhs.prefix < a_rhs.prefix :
+                           stl::cistring_less{}(a_lhs.name, a_rhs.name);
+			}
+
+			std::uint64_t prefix{ 0 };
+			std::string_view name;
+		};
+
+		// every ini and game setting, deduplicated and sorted by name, with a case folded copy of each name
+		class SettingCatalog
+		{
+		public:
+			struct Entry
+			{
+			public:
+				std::string_view name;
+				std::string_view folded;
+				RE::Setting* setting{ nullptr };
+			};
+
+			SettingCatalog() = default;
+			SettingCatalog(const SettingCatalog&) = delete;
+			SettingCatalog(SettingCatalog&&) = delete;
+
+			~SettingCatalog() = default;
+
+			SettingCatalog& operator=(const SettingCatalog&) = delete;
+			SettingCatalog& operator=(SettingCatalog&&) = delete;
+
+			[[nodiscard]] std::span<const Entry> entries() const noexcept { return { _entries.data(), _entries.size() }; }
+
+			// preference settings shadow ini settings of the same name
+			void build(std::span<RE::INISettingCollection* const> a_inis, const RE::GameSettingCollection* a_gmst)
+			{
+				robin_hood::unordered_flat_map<std::string_view, RE::Setting*> map;
+				for (const auto ini : a_inis) {
+					if (ini) {
+						for (const auto setting : ini->settings) {
+							if (setting) {
+								map.insert_or_assign(setting->GetKey(), setting);
+							}
 						}
-						return arr;
-					});
+					}
+				}
 
+				std::vector<std::pair<SettingKey, RE::Setting*>> sorted;
+				sorted.reserve(map.size() + (a_gmst ? a_gmst->settings.size() : 0));
+				for (const auto& [name, setting] : map) {
+					sorted.emplace_back(SettingKey{ name }, setting);
+				}
+				if (a_gmst) {
+					for (const auto& [name, setting] : a_gmst->settings) {
+						if (setting) {
+							sorted.emplace_back(SettingKey{ name }, setting);
+						}
+					}
+				}
 				std::sort(
-					matches.begin(),
-					matches.end(),
+					sorted.begin(),
+					sorted.end(),
 					[](auto&& a_lhs, auto&& a_rhs) noexcept {
-						return a_lhs->GetFormType() != a_rhs->GetFormType() ?
-					               a_lhs->GetFormType() < a_rhs->GetFormType() :
-                                   a_lhs->GetFormID() < a_rhs->GetFormID();
+						return a_lhs.first < a_rhs.first;
 					});
-				const auto& formTypeMap = FormTypeMap::get();
-				std::string buf;
-				for (const auto match : matches) {
-					buf.clear();
-					if (const auto filename = [&]() {
-							const auto file = match->GetDescriptionOwnerFile();
-							return file ? file->GetFilename() : ""sv;
-						}();
-						!filename.empty()) {
-						buf += filename;
-						buf += ' ';
+
+				_entries.reserve(sorted.size());
+				for (const auto& [key, setting] : sorted) {
+					const auto handle = _names.push_back_folded(key.name);
+					_entries.push_back({ _names.view(handle), _names.view_folded(handle), setting });
+				}
+			}
+
+		private:
+			StringArena _names;
+			std::vector<Entry> _entries;
+		};
+
+		// must be called from the console thread
+		// the collections only grow or shrink while settings are registered, so their sizes are enough to spot a change
+		[[nodiscard]] inline std::shared_ptr<const SettingCatalog> GetSettingCatalog()
+		{
+			const auto inis = stl::make_array(
+				RE::INISettingCollection::GetSingleton(),
+				RE::INIPrefSettingCollection::GetSingleton());
+			const auto gmst = RE::GameSettingCollection::GetSingleton();
+
+			std::array<std::size_t, std::tuple_size_v<decltype(inis)> + 1> sizes{};
+			for (std::size_t i = 0; i < inis.size(); ++i) {
+				if (inis[i]) {
+					for ([[maybe_unused]] const auto setting : inis[i]->settings) {
+						++sizes[i];
 					}
+				}
+			}
+			sizes.back() = gmst ? gmst->settings.size() : 0;
+
+			static std::optional<decltype(sizes)> last;
+			static std::shared_ptr<const SettingCatalog> catalog;
+			if (last != sizes) {
+				auto rebuilt = std::make_shared<SettingCatalog>();
+				rebuilt->build(inis, gmst);
+				catalog = std::move(rebuilt);
+				last = sizes;
+			}
+			return catalog;
+		}
+
+		// the value of every setting in a catalog, in catalog order
+		// setini can change a setting, or reallocate a string one, while the worker formats it, so values are copied up front
+		class SettingValues
+		{
+		public:
+			using Type = RE::Setting::SETTING_TYPE;
+
+			struct Value
+			{
+			public:
+				Type type{ Type::kUnknown };
+				std::variant<
+					std::monostate,
+					bool,
+					char,
+					std::uint8_t,
+					std::int32_t,
+					std::uint32_t,
+					float,
+					std::string_view,
+					std::array<std::uint8_t, 3>,
+					std::array<std::uint8_t, 4>>
+					value;
+			};
+
+			SettingValues() = default;
+			SettingValues(const SettingValues&) = delete;
+			SettingValues(SettingValues&&) = delete;
+
+			~SettingValues() = default;
+
+			SettingValues& operator=(const SettingValues&) = delete;
+			SettingValues& operator=(SettingValues&&) = delete;
+
+			[[nodiscard]] const Value& operator[](std::size_t a_index) const noexcept { return _values[a_index]; }
+
+			// must be called from the console thread
+			void capture(const SettingCatalog& a_catalog)
+			{
+				const auto entries = a_catalog.entries();
+				_values.reserve(entries.size());
+				for (const auto& entry : entries) {
+					const auto setting = entry.setting;
+					auto& value = _values.emplace_back(Value{ setting->GetType() });
+					switch (value.type) {
+					case Type::kBinary:
+						value.value = setting->GetBinary();
+						break;
+					case Type::kChar:
+						value.value = setting->GetChar();
+						break;
+					case Type::kUChar:
+						value.value = setting->GetUChar();
+						break;
+					case Type::kInt:
+						value.value = setting->GetInt();
+						break;
+					case Type::kUInt:
+						value.value = setting->GetUInt();
+						break;
+					case Type::kFloat:
+						value.value = setting->GetFloat();
+						break;
+					case Type::kString:
+						value.value = _strings.view(_strings.push_back(stl::safe_string(setting->GetString())));
+						break;
+					case Type::kRGB:
+						value.value = setting->GetRGB();
+						break;
+					case Type::kRGBA:
+						value.value = setting->GetRGBA();
+						break;
+					default:
+						break;
+					}
+				}
+			}
+
+		private:
+			StringArena _strings;
+			std::vector<Value> _values;
+		};
+
+		// a global's value, copied on the console thread since the set command can change it while the worker formats it
+		struct GlobalRecord
+		{
+		public:
+			std::uint32_t formID{ 0 };
+			float value{ 0.0F };
+		};
+
+		// everything a query reads from the game, captured on the console thread before matching starts
+		class Query
+		{
+		public:
+			Query() = default;
+			Query(const Query&) = delete;
+			Query(Query&&) = delete;
+
+			~Query() = default;
+
+			Query& operator=(const Query&) = delete;
+			Query& operator=(Query&&) = delete;
+
+			std::string matchstring;
+			Matcher matcher;
+			Filter filter{ Filter::kAll };
+			std::optional<RE::ENUM_FORM_ID> formtype;
+			Page page;
+			std::shared_ptr<const EditorIDCache::Cache> idCache;
+			std::shared_ptr<DisplayNameCache::Table> names;
+			std::shared_ptr<const FormSet> forms;    // plugin forms
+			std::shared_ptr<const FormSet> created;  // forms created at runtime
+			bool refined{ false };
+			std::vector<GlobalRecord> globals;
+			std::shared_ptr<const SettingCatalog> settings;
+			SettingValues settingValues;
+		};
+
+		// the form types whose plugin forms all had editor ids when every form was last scanned
+		// the editor id cache buckets those types by itself, so filtering on them doesn't need to visit every form
+		class Coverage
+		{
+		public:
+			static constexpr auto TYPES = static_cast<std::size_t>(stl::to_underlying(RE::ENUM_FORM_ID::kTotal));
+
+			[[nodiscard]] static Coverage& get()
+			{
+				static Coverage singleton;
+				return singleton;
+			}
+
+			[[nodiscard]] bool complete(RE::ENUM_FORM_ID a_type, std::uint64_t a_epoch) const noexcept
+			{
+				const auto i = static_cast<std::size_t>(stl::to_underlying(a_type));
+				return _valid && _epoch == a_epoch && i < TYPES && !_incomplete[i];
+			}
+
+			void assign(std::uint64_t a_epoch, const std::bitset<TYPES>& a_incomplete) noexcept
+			{
+				_epoch = a_epoch;
+				_incomplete = a_incomplete;
+				_valid = true;
+			}
+
+		private:
+			Coverage() = default;
+
+			std::bitset<TYPES> _incomplete;
+			std::uint64_t _epoch{ 0 };
+			bool _valid{ false };
+		};
+
+		// the all forms lock is held for as little of the snapshot as possible, since it stalls every thread creating forms
+		inline void SnapshotForms(Query& a_query)
+		{
+			const auto [allForms, allFormsMapLock] = RE::TESForm::GetAllForms();
+			if (!allForms) {
+				return;
+			}
+
+			auto forms = std::make_shared<FormSet>();
+			auto created = std::make_shared<FormSet>();
+			const auto& idCache = *a_query.idCache;
+			const auto wanted = [&](const RE::TESForm& a_form) {
+				return !a_query.formtype || a_form.GetFormType() == *a_query.formtype;
+			};
+
+			RE::BSAutoReadLock l{ allFormsMapLock };
+			a_query.forms = Refinements::get().find(
+				Refinements::make_key(a_query.filter, a_query.formtype),
+				a_query.matcher.literal(),
+				idCache.epoch(),
+				a_query.names);
+			if (a_query.forms) {
+				a_query.refined = true;
+			} else if (a_query.formtype && Coverage::get().complete(*a_query.formtype, idCache.epoch())) {
+				for (const auto formID : idCache.bucket(*a_query.formtype)) {
+					const auto it = allForms->find(formID);
+					if (it != allForms->end() && it->second && !it->second->IsCreated() && wanted(*it->second)) {
+						forms->push_back(*it->second);
+					}
+				}
+				a_query.forms = std::move(forms);
+			} else {
+				std::bitset<Coverage::TYPES> incomplete;
+				for (const auto& [formID, form] : *allForms) {
+					if (!form || form->IsCreated()) {
+						continue;
+					}
+
+					if (a_query.formtype) {
+						if (const auto i = static_cast<std::size_t>(stl::to_underlying(form->GetFormType()));
+							i < incomplete.size() && !idCache.find(formID)) {
+							incomplete.set(i);
+						}
+					}
+					if (wanted(*form)) {
+						forms->push_back(*form);
+					}
+				}
+				if (a_query.formtype) {
+					Coverage::get().assign(idCache.epoch(), incomplete);
+				}
+				a_query.forms = std::move(forms);
+			}
+
+			CreatedForms::get().for_each(*allForms, [&](RE::TESForm& a_form) {
+				if (wanted(a_form)) {
+					created->push_back(a_form);
+				}
+			});
+			a_query.created = std::move(created);
+		}
+
+		inline void SnapshotEditorID(Query& a_query)
+		{
+			auto forms = std::make_shared<FormSet>();
+			const auto formID = a_query.idCache->find(a_query.matchstring);
+			const auto form = formID ? RE::TESForm::GetFormByID(*formID) : nullptr;
+			if (form) {
+				forms->push_back(*form);
+			}
+			a_query.forms = std::move(forms);
+		}
+
+		inline void SnapshotGlobals(Query& a_query)
+		{
+			const auto dataHandler = RE::TESDataHandler::GetSingleton();
+			const auto& globals = dataHandler->GetFormArray<RE::TESGlobal>();
+			a_query.globals.reserve(globals.size());
+			for (const auto global : globals) {
+				if (global) {
+					a_query.globals.push_back({ global->GetFormID(), global->value });
+				}
+			}
+		}
 
-					if (const auto typeString = formTypeMap.find(match->GetFormType());
-						typeString) {
-						buf += *typeString;
+		inline void SnapshotSettings(Query& a_query)
+		{
+			a_query.settings = GetSettingCatalog();
+			a_query.settingValues.capture(*a_query.settings);
+		}
+
+		inline void Snapshot(Query& a_query)
+		{
+			const Metrics::Timer timer{ Metrics::Metric::kHelpSnapshot };
+			if (a_query.filter == Filter::kAll || a_query.filter == Filter::kSettings) {
+				SnapshotSettings(a_query);
+			}
+
+			if (a_query.filter == Filter::kAll || a_query.filter == Filter::kGlobals) {
+				SnapshotGlobals(a_query);
+			}
+
+			if (a_query.filter == Filter::kAll || a_query.filter == Filter::kForms) {
+				SnapshotForms(a_query);
+			}
+
+			if (a_query.filter == Filter::kEditorID) {
+				SnapshotEditorID(a_query);
+			}
+		}
+
+		inline void EnumerateForms(Output& a_out, const Query& a_query, const std::stop_token& a_stop)
+		{
+			a_out.append("----OTHER FORMS--------------------\n"sv);
+			if (!a_query.forms) {
+				return;
+			}
+
+			const auto& idCache = *a_query.idCache;
+			auto& names = *a_query.names;
+			const auto literals = a_query.matcher.literals();
+
+			std::vector<const FormRecord*> candidates;
+			{
+				const Metrics::Timer timer{ Metrics::Metric::kHelpGather };
+
+				// forms with editor ids are covered by the trigram indices, everything else still has to be scanned
+				const auto hits = [&]() -> std::optional<std::vector<std::uint32_t>> {
+					std::vector<std::uint32_t> result;
+					std::shared_ptr<const DisplayNames> displayNames;
+					for (const auto literal : literals) {
+						const auto editorIDs = idCache.trigrams().find(literal);
+						if (!editorIDs) {
+							return std::nullopt;
+						}
+
+						if (!displayNames) {
+							displayNames = GetDisplayNames(idCache, a_query.names);
+						}
+						const auto nameIDs = displayNames->trigrams().find(literal);
+						for (const auto ids : { std::addressof(*editorIDs), std::addressof(*nameIDs) }) {
+							std::vector<std::uint32_t> merged;
+							std::set_union(
+								result.begin(),
+								result.end(),
+								ids->begin(),
+								ids->end(),
+								std::back_inserter(merged));
+							result = std::move(merged);
+						}
 					}
+					return result;
+				}();
 
-					buf += ':';
+				for (const auto& record : a_query.forms->records) {
+					if (!hits ||
+						std::binary_search(hits->begin(), hits->end(), record.formID) ||
+						!idCache.find(record.formID)) {
+						candidates.push_back(std::addressof(record));
+					}
+				}
+				if (a_query.created) {
+					for (const auto& record : a_query.created->records) {
+						candidates.push_back(std::addressof(record));
+					}
+				}
+			}
 
-					if (const auto editorID = idCache->find(match->GetFormID());
-						editorID) {
-						buf += ' ';
-						buf += *editorID;
+			const auto matches = Enumerate(
+				a_stop,
+				a_query.matcher,
+				std::span{ candidates.data(), candidates.size() },
+				[&](auto&& a_form, auto&& a_match) {
+					if (const auto editorID = idCache.find_folded(a_form->formID); editorID) {
+						if (a_match(FoldedString{ *editorID })) {
+							return true;
+						}
+					} else if (const auto unfolded = idCache.find(a_form->formID); unfolded && a_match(*unfolded)) {
+						return true;
 					}
 
-					buf += fmt::format(FMT_STRING(" ({:08X})"), match->GetFormID());
+					// only resolved when the editor id misses
+					return a_form->created() ?
+                               a_match(a_form->name) :
+                               a_match(FoldedString{ names.resolve_folded(*a_form->form) });
+				},
+				FormKey,
+				a_query.page,
+				a_query.matcher.substring());
+
+			if (a_stop.stop_requested()) {
+				return;
+			}
 
-					if (const auto displayName = getDisplayName(*match);
-						!displayName.empty()) {
-						buf += ' ';
-						buf += displayName;
+			// created forms are left out, so the refinement stays valid however they churn
+			if (a_query.matcher.substring()) {
+				const auto plugin = static_cast<std::size_t>(std::count_if(
+					matches.all.begin(),
+					matches.all.end(),
+					[](auto&& a_match) noexcept { return !a_match->created(); }));
+				if (!a_query.refined || plugin < a_query.forms->records.size()) {
+					auto refinement = std::make_shared<FormSet>();
+					refinement->records.reserve(plugin);
+					for (const auto match : matches.all) {
+						if (!match->created()) {
+							refinement->push_back(*match);
+						}
 					}
 
-					buf += '\n';
-					Print(buf);
+					Refinements::get().insert(
+						Refinements::make_key(a_query.filter, a_query.formtype),
+						{ std::string{ a_query.matcher.literal() }, idCache.epoch(), a_query.names, std::move(refinement) });
 				}
 			}
+
+			for (const auto match : matches.items) {
+				FormatForm(a_out.buffer(), *match, idCache, names);
+				a_out.commit();
+			}
+			PrintPage(a_out, matches, a_query.page);
+		}
+
+		inline void LookupEditorID(Output& a_out, const Query& a_query)
+		{
+			a_out.append("----EDITOR ID---------------------------\n"sv);
+			for (const auto& record : a_query.forms->records) {
+				FormatForm(a_out.buffer(), record, *a_query.idCache, *a_query.names);
+				a_out.commit();
+			}
 		}
 
-		inline void EnumerateFunctions(std::string_view a_matchstring)
+		inline void EnumerateFunctions(Output& a_out, const Query& a_query, const std::stop_token& a_stop)
 		{
-			const auto print = [](const std::vector<RE::SCRIPT_FUNCTION*>& a_todo) {
-				std::string line;
-				for (auto& elem : a_todo) {
-					line = stl::safe_string(elem->functionName);
+			const auto print = [&](const Matches<const FunctionIndex::Function*>& a_todo) {
+				for (const auto match : a_todo.items) {
+					const auto elem = match->function;
+					auto& line = a_out.buffer();
+					Append(line, stl::safe_string(elem->functionName));
 
 					if (const auto shortName = stl::safe_string(elem->shortName);
 						!shortName.empty()) {
-						line += " ("sv;
-						line += shortName;
-						line += ')';
+						Append(line, " ("sv);
+						Append(line, shortName);
+						Append(line, ')');
 					}
 
 					if (const auto helpString = stl::safe_string(elem->helpString);
 						!helpString.empty()) {
-						line += " -> "sv;
-						line += helpString;
+						Append(line, " -> "sv);
+						Append(line, helpString);
 					}
 
-					line += '\n';
-					Print(line);
+					Append(line, '\n');
+					a_out.commit();
 				}
+				PrintPage(a_out, a_todo, a_query.page);
 			};
 
-			const auto functor = [](const RE::SCRIPT_FUNCTION& a_elem) noexcept {
-				return std::array{
-					stl::safe_string(a_elem.functionName),
-					stl::safe_string(a_elem.shortName)
-				};
+			const auto functor = [](const FunctionIndex::Function& a_elem, auto&& a_match) noexcept {
+				return a_match(FoldedString{ a_elem.functionName }) ||
+				       a_match(FoldedString{ a_elem.shortName });
 			};
 
-			Print("----CONSOLE COMMANDS--------------------\n"sv);
+			// the function tables are static, and are only rewritten while plugins load
+			// functions are listed in table order
+			const auto& index = FunctionIndex::get();
+			a_out.append("----CONSOLE COMMANDS--------------------\n"sv);
 			print(Enumerate(
-				a_matchstring,
-				RE::SCRIPT_FUNCTION::GetConsoleFunctions(),
-				functor));
+				a_stop,
+				a_query.matcher,
+				index.console().functions(),
+				functor,
+				std::identity{},
+				a_query.page));
 
-			Print("----SCRIPT FUNCTIONS--------------------\n"sv);
+			a_out.append("----SCRIPT FUNCTIONS--------------------\n"sv);
 			print(Enumerate(
-				a_matchstring,
-				RE::SCRIPT_FUNCTION::GetScriptFunctions(),
-				functor));
+				a_stop,
+				a_query.matcher,
+				index.script().functions(),
+				functor,
+				std::identity{},
+				a_query.page));
 		}
 
-		inline void EnumerateGlobals(std::string_view a_matchstring)
+		inline void EnumerateGlobals(Output& a_out, const Query& a_query, const std::stop_token& a_stop)
 		{
-			Print("----GLOBAL VARIABLES--------------------\n"sv);
-			const auto dataHandler = RE::TESDataHandler::GetSingleton();
-			const auto& globals = dataHandler->GetFormArray<RE::TESGlobal>();
-			const auto cache = EditorIDCache::get().access();
-			auto matches = Enumerate(
-				a_matchstring,
-				std::span{ globals.begin(), globals.size() },
-				[&](const RE::TESGlobal* a_global) noexcept {
-					boost::container::static_vector<std::string_view, 1> arr;
-					const auto editorID = a_global ? cache->find(a_global->GetFormID()) : nullptr;
-					if (editorID) {
-						arr.emplace_back(*editorID);
-					}
-					return arr;
-				});
+			a_out.append("----GLOBAL VARIABLES--------------------\n"sv);
+			const auto& cache = *a_query.idCache;
+			const auto matches = Enumerate(
+				a_stop,
+				a_query.matcher,
+				std::span{ a_query.globals.data(), a_query.globals.size() },
+				[&](const GlobalRecord& a_global, auto&& a_match) noexcept {
+					const auto editorID = cache.find(a_global.formID);
+					return editorID && a_match(*editorID);
+				},
+				[](const GlobalRecord* a_global) noexcept {
+					return a_global->formID;
+				},
+				a_query.page);
 
-			std::sort(
-				matches.begin(),
-				matches.end(),
-				[](auto&& a_lhs, auto&& a_rhs) {
-					return a_lhs->GetFormID() < a_rhs->GetFormID();
-				});
-			std::string buf;
-			for (const auto match : matches) {
-				buf = fmt::format(
+			for (const auto match : matches.items) {
+				fmt::format_to(
+					std::back_inserter(a_out.buffer()),
 					FMT_STRING("{} = {:0.2f}\n"),
-					*cache->find(match->GetFormID()),
+					*cache.find(match->formID),
 					match->value);
-				Print(buf);
+				a_out.commit();
 			}
+			PrintPage(a_out, matches, a_query.page);
 		}
 
-		inline void EnumerateSettings(std::string_view a_matchstring)
+		inline void EnumerateSettings(Output& a_out, const Query& a_query, const std::stop_token& a_stop)
 		{
-			Print("----SETTINGS----------------------------\n"sv);
+			a_out.append("----SETTINGS----------------------------\n"sv);
+			const auto matches = Enumerate(
+				a_stop,
+				a_query.matcher,
+				a_query.settings->entries(),
+				[](auto&& a_elem, auto&& a_match) {
+					return a_match(FoldedString{ a_elem.folded });
+				},
+				std::identity{},  // the catalog is already sorted
+				a_query.page);
 
-			auto candidates = []() {
-				robin_hood::unordered_flat_map<std::string_view, RE::Setting*> map;
-				const auto inis = stl::make_array(
-					RE::INISettingCollection::GetSingleton(),
-					RE::INIPrefSettingCollection::GetSingleton());
-				for (const auto ini : inis) {
-					if (ini) {
-						for (const auto setting : ini->settings) {
-							if (setting) {
-								map.insert_or_assign(setting->GetKey(), setting);
-							}
-						}
-					}
-				}
-				return std::vector<decltype(map)::value_type>{ map.begin(), map.end() };
-			}();
-
-			if (const auto gmst = RE::GameSettingCollection::GetSingleton(); gmst) {
-				for (const auto& [name, setting] : gmst->settings) {
-					if (setting) {
-						candidates.emplace_back(name, setting);
-					}
-				}
-			}
-
-			auto matches = Enumerate(
-				a_matchstring,
-				std::span{ candidates.data(), candidates.size() },
-				[](auto&& a_elem) {
-					return std::array{ a_elem.first };
-				});
-
-			std::sort(
-				matches.begin(),
-				matches.end(),
-				[](auto&& a_lhs, auto&& a_rhs) {
-					return _stricmp(a_lhs->first.data(), a_rhs->first.data()) < 0;
-				});
-			std::string buf;
-			for (const auto match : matches) {
-				const auto& [name, setting] = *match;
-				using Type = RE::Setting::SETTING_TYPE;
-				switch (setting->GetType()) {
+			const auto entries = a_query.settings->entries();
+			for (const auto match : matches.items) {
+				const auto out = std::back_inserter(a_out.buffer());
+				const auto name = match->name;
+				const auto& [type, value] = a_query.settingValues[static_cast<std::size_t>(match - entries.data())];
+				using Type = SettingValues::Type;
+				switch (type) {
 				case Type::kBinary:
-					buf = fmt::format(FMT_STRING("{} = {}\n"), name, setting->GetBinary());
+					fmt::format_to(out, FMT_STRING("{} = {}\n"), name, std::get<bool>(value));
 					break;
 				case Type::kChar:
-					buf = fmt::format(FMT_STRING("{} = {}\n"), name, setting->GetChar());
+					fmt::format_to(out, FMT_STRING("{} = {}\n"), name, std::get<char>(value));
 					break;
 				case Type::kUChar:
-					buf = fmt::format(FMT_STRING("{} = {:#04x}\n"), name, setting->GetUChar());
+					fmt::format_to(out, FMT_STRING("{} = {:#04x}\n"), name, std::get<std::uint8_t>(value));
 					break;
 				case Type::kInt:
-					buf = fmt::format(FMT_STRING("{} = {}\n"), name, setting->GetInt());
+					fmt::format_to(out, FMT_STRING("{} = {}\n"), name, std::get<std::int32_t>(value));
 					break;
 				case Type::kUInt:
-					buf = fmt::format(FMT_STRING("{} = {}\n"), name, setting->GetUInt());
+					fmt::format_to(out, FMT_STRING("{} = {}\n"), name, std::get<std::uint32_t>(value));
 					break;
 				case Type::kFloat:
-					buf = fmt::format(FMT_STRING("{} = {:0.2f}\n"), name, setting->GetFloat());
+					fmt::format_to(out, FMT_STRING("{} = {:0.2f}\n"), name, std::get<float>(value));
 					break;
 				case Type::kString:
-					buf = fmt::format(FMT_STRING("{} = {}\n"), name, setting->GetString());
+					fmt::format_to(out, FMT_STRING("{} = {}\n"), name, std::get<std::string_view>(value));
 					break;
 				case Type::kRGB:
 					{
-						const auto rgb = setting->GetRGB();
-						buf = fmt::format(FMT_STRING("{} = R:{} G:{} B:{}\n"), name, rgb[0], rgb[1], rgb[2]);
+						const auto& rgb = std::get<std::array<std::uint8_t, 3>>(value);
+						fmt::format_to(out, FMT_STRING("{} = R:{} G:{} B:{}\n"), name, rgb[0], rgb[1], rgb[2]);
 					}
+					break;
 				case Type::kRGBA:
 					{
-						const auto rgba = setting->GetRGBA();
-						buf = fmt::format(FMT_STRING("{} = R:{} G:{} B:{} A:{}\n"), name, rgba[0], rgba[1], rgba[2], rgba[3]);
+						const auto& rgba = std::get<std::array<std::uint8_t, 4>>(value);
+						fmt::format_to(out, FMT_STRING("{} = R:{} G:{} B:{} A:{}\n"), name, rgba[0], rgba[1], rgba[2], rgba[3]);
 					}
 					break;
 				default:
-					buf = fmt::format(FMT_STRING("{} = <UNKNOWN>\n"), name);
+					fmt::format_to(out, FMT_STRING("{} = <UNKNOWN>\n"), name);
 					break;
 				}
-				Print(buf);
+				a_out.commit();
 			}
+			PrintPage(a_out, matches, a_query.page);
 		}
 
-		inline bool Execute(
-			const RE::SCRIPT_PARAMETER* a_parameters,
-			const char* a_compiledParams,
-			RE::TESObjectREFR* a_refObject,
-			RE::TESObjectREFR* a_container,
-			RE::Script* a_script,
-			RE::ScriptLocals* a_scriptLocals,
-			float&,
-			std::uint32_t& a_offset)
+		inline void Run(const Query& a_query, const std::stop_token& a_stop)
+		{
+			// the sections share one buffer, so their output is posted in order
+			Output out{ a_stop };
+			const auto section = [&](Filter a_filter, auto a_func) {
+				if ((a_query.filter == Filter::kAll || a_query.filter == a_filter) && !a_stop.stop_requested()) {
+					a_func(out, a_query, a_stop);
+				}
+			};
+
+			section(Filter::kFunctions, EnumerateFunctions);
+			section(Filter::kSettings, EnumerateSettings);
+			section(Filter::kGlobals, EnumerateGlobals);
+			section(Filter::kForms, EnumerateForms);
+
+			if (a_query.filter == Filter::kEditorID) {
+				LookupEditorID(out, a_query);
+			}
+		}
+
+		// queries run on a worker thread, and a new query cancels the one before it
+		// workers are serialized, so a cancelled query always finishes before the next one starts
+		inline void Dispatch(std::unique_ptr<Query> a_query)
 		{
-			auto [matchstring, filter, formtype] = Parse(a_parameters, a_compiledParams, a_offset, a_refObject, a_container, a_script, a_scriptLocals);
+			static std::stop_source running;
+			running.request_stop();
+			running = {};
 
-			if (!matchstring) {
+			std::thread([query = std::move(a_query), stop = running.get_token()]() {
+				static std::mutex lock;
+				const std::lock_guard l{ lock };
+				if (!stop.stop_requested()) {
+					Run(*query, stop);
+				}
+			}).detach();
+		}
+
+		// validates the arguments and builds a query from them, or prints why they're invalid and returns nothing
+		[[nodiscard]] inline std::unique_ptr<Query> MakeQuery(
+			std::optional<std::string> a_matchstring,
+			std::optional<Filter> a_filter,
+			std::optional<std::string> a_formtype,
+			std::optional<std::int32_t> a_limit,
+			std::optional<std::int32_t> a_page)
+		{
+			if (a_formtype && *a_formtype == "*"sv) {
+				a_formtype.reset();
+			}
+
+			if (!a_matchstring) {
 				Print(HelpString() + '\n');
-				return true;
-			} else if (filter && (*filter < static_cast<Filter>(0) || *filter >= Filter::kTotal)) {
+				return nullptr;
+			} else if (a_filter && (*a_filter < static_cast<Filter>(0) || *a_filter >= Filter::kTotal)) {
 				Print("<filter> must be a valid filter\n"sv);
-				return true;
-			} else if (formtype && formtype->length() != 4) {
+				return nullptr;
+			} else if (a_formtype && a_formtype->length() != 4) {
 				Print("<form-type> must be 4 characters in length\n"sv);
-				return true;
-			} else if ([](std::optional<std::string>& a_formtype) {
-						   if (a_formtype) {
-							   for (auto& ch : *a_formtype) {
+				return nullptr;
+			} else if ([](std::optional<std::string>& a_type) {
+						   if (a_type) {
+							   for (auto& ch : *a_type) {
 								   ch = stl::toupper(ch);
 							   }
-							   return !FormTypeMap::get().find(*a_formtype);
+							   return !FormTypeMap::find(*a_type);
 						   } else {
 							   return false;
 						   }
-					   }(formtype)) {
+					   }(a_formtype)) {
 				Print("<form-type> must be a valid form type\n"sv);
-				return true;
+				return nullptr;
+			} else if (a_limit && *a_limit < 0) {
+				Print("<limit> must not be negative\n"sv);
+				return nullptr;
+			} else if (a_page && *a_page < 1) {
+				Print("<page> must be at least 1\n"sv);
+				return nullptr;
 			}
 
-			for (auto& ch : *matchstring) {
+			auto query = std::make_unique<Query>();
+			query->matchstring = std::move(*a_matchstring);
+			for (auto& ch : query->matchstring) {
 				ch = stl::tolower(ch);
 			}
 
-			if (!filter) {
-				filter = Filter::kAll;
-			}
-
-			if (*filter == Filter::kAll || *filter == Filter::kFunctions) {
-				EnumerateFunctions(*matchstring);
-			}
-
-			if (*filter == Filter::kAll || *filter == Filter::kSettings) {
-				EnumerateSettings(*matchstring);
+			query->filter = a_filter.value_or(Filter::kAll);
+			if (query->filter != Filter::kEditorID) {
+				auto matcher = MakeMatcher(query->matchstring);
+				if (!matcher) {
+					Print("<matchstring> must be a valid pattern\n"sv);
+					return nullptr;
+				}
+				query->matcher = std::move(*matcher);
 			}
 
-			if (*filter == Filter::kAll || *filter == Filter::kGlobals) {
-				EnumerateGlobals(*matchstring);
-			}
+			query->formtype = a_formtype ? FormTypeMap::find(*a_formtype) : std::nullopt;
+			query->page = Page{
+				static_cast<std::size_t>(a_limit.value_or(0)),
+				static_cast<std::size_t>(a_page.value_or(1) - 1)
+			};
+			query->idCache = EditorIDCache::get().snapshot();
+			query->names = DisplayNameCache::get().table();
+			return query;
+		}
 
-			if (*filter == Filter::kAll || *filter == Filter::kForms) {
-				EnumerateForms(
-					*matchstring,
-					(formtype ? FormTypeMap::get().find(*formtype) : std::nullopt));
+		inline bool Execute(
+			const RE::SCRIPT_PARAMETER* a_parameters,
+			const char* a_compiledParams,
+			RE::TESObjectREFR* a_refObject,
+			RE::TESObjectREFR* a_container,
+			RE::Script* a_script,
+			RE::ScriptLocals* a_scriptLocals,
+			float&,
+			std::uint32_t& a_offset)
+		{
+			auto [matchstring, filter, formtype, limit, page] = Parse(a_parameters, a_compiledParams, a_offset, a_refObject, a_container, a_script, a_scriptLocals);
+			auto query = MakeQuery(std::move(matchstring), filter, std::move(formtype), limit, page);
+			if (query) {
+				Snapshot(*query);
+				Dispatch(std::move(query));
 			}
-
 			return true;
 		}
 
@@ -467,18 +1666,14 @@ namespace CC::Help
 
 	inline void Install()
 	{
-		const auto functions = RE::SCRIPT_FUNCTION::GetConsoleFunctions();
-		const auto it = std::find_if(
-			functions.begin(),
-			functions.end(),
-			[&](auto&& a_elem) {
-				return _stricmp(a_elem.functionName, detail::LONG_NAME.data()) == 0;
-			});
-		if (it != functions.end()) {
+		const auto it = FunctionIndex::get().console().find(detail::LONG_NAME);
+		if (it) {
 			static std::array params{
 				RE::SCRIPT_PARAMETER{ "String (Optional)", RE::SCRIPT_PARAM_TYPE::kChar, true },
 				RE::SCRIPT_PARAMETER{ "Integer (Optional)", RE::SCRIPT_PARAM_TYPE::kInt, true },
 				RE::SCRIPT_PARAMETER{ "String (Optional)", RE::SCRIPT_PARAM_TYPE::kChar, true },
+				RE::SCRIPT_PARAMETER{ "Integer (Optional)", RE::SCRIPT_PARAM_TYPE::kInt, true },
+				RE::SCRIPT_PARAMETER{ "Integer (Optional)", RE::SCRIPT_PARAM_TYPE::kInt, true },
 			};
 
 			*it = RE::SCRIPT_FUNCTION{ detail::LONG_NAME.data(), detail::SHORT_NAME.data(), it->output };
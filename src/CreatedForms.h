@@ -0,0 +1,94 @@
+#pragma once
+
+#include "FormHooks.h"
+
+// the ids of the forms created at runtime, recorded as the game registers them
+// created forms are a tiny fraction of every form, so queries visit these instead of walking the whole all forms map
+// destroyed forms are only forgotten once a walk fails to find them, since nothing needs to know sooner
+class CreatedForms
+{
+public:
+	CreatedForms(const CreatedForms&) = delete;
+	CreatedForms(CreatedForms&&) = delete;
+
+	CreatedForms& operator=(const CreatedForms&) = delete;
+	CreatedForms& operator=(CreatedForms&&) = delete;
+
+	[[nodiscard]] static CreatedForms& get()
+	{
+		static CreatedForms singleton;
+		return singleton;
+	}
+
+	void install()
+	{
+		Hooks::Install("created form"sv);
+	}
+
+	// calls the functor with every created form still registered, and forgets the rest
+	// the all forms lock must be held
+	template <class F>
+	void for_each(const RE::BSTHashMap<std::uint32_t, RE::TESForm*>& a_allForms, F a_func)
+	{
+		const std::lock_guard l{ _lock };
+		_dead.clear();
+		for (const auto formID : _ids) {
+			const auto it = a_allForms.find(formID);
+			if (it != a_allForms.end() && it->second && it->second->GetFormID() == formID) {
+				a_func(*it->second);
+			} else {
+				_dead.push_back(formID);
+			}
+		}
+		for (const auto formID : _dead) {
+			_ids.erase(formID);
+		}
+	}
+
+private:
+	CreatedForms() = default;
+
+	~CreatedForms() = default;
+
+	void insert(std::uint32_t a_formID)
+	{
+		const std::lock_guard l{ _lock };
+		_ids.insert(a_formID);
+	}
+
+	template <class T>
+	class Hook
+	{
+	public:
+		[[nodiscard]] static std::uintptr_t slot()
+		{
+			REL::Relocation<std::uintptr_t> vtable{ T::VTABLE[0] };
+			return vtable.address() + 0x40 * sizeof(std::uintptr_t);
+		}
+
+		// the slot's page must already be writable
+		static void attach(std::uintptr_t a_slot)
+		{
+			auto& vfunc = *reinterpret_cast<std::uintptr_t*>(a_slot);
+			_original = vfunc;
+			vfunc = reinterpret_cast<std::uintptr_t>(SetFormID);
+		}
+
+	private:
+		static void SetFormID(RE::TESForm* a_this, std::uint32_t a_formID, bool a_updateFile)
+		{
+			_original(a_this, a_formID, a_updateFile);
+			if ((a_formID >> 24) == 0xFF) {
+				CreatedForms::get().insert(a_formID);
+			}
+		}
+
+		static inline REL::Relocation<decltype(&RE::TESForm::SetFormID)> _original;
+	};
+
+	using Hooks = FormHooks<Hook>;
+
+	std::mutex _lock;
+	robin_hood::unordered_flat_set<std::uint32_t> _ids;
+	std::vector<std::uint32_t> _dead;
+};
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "StringArena.h"
+
+// the display names of forms loaded from plugins, resolved on first use and kept for the rest of the table's life
+// names are copied alongside a case folded shadow, so lookups never touch the form or the game's string pool again
+class DisplayNameCache
+{
+public:
+	using key_type = std::uint32_t;
+
+	class Table
+	{
+	public:
+		Table() = default;
+		Table(const Table&) = delete;
+		Table(Table&&) = delete;
+
+		~Table() = default;
+
+		Table& operator=(const Table&) = delete;
+		Table& operator=(Table&&) = delete;
+
+		// created forms can be destroyed and their ids reused, so their names are never cached
+		[[nodiscard]] std::string_view resolve(RE::TESForm& a_form)
+		{
+			return !a_form.IsCreated() ? _arena.view(handle(a_form)) : Resolve(a_form);
+		}
+
+		// only valid for forms loaded from plugins
+		[[nodiscard]] std::string_view resolve_folded(RE::TESForm& a_form)
+		{
+			assert(!a_form.IsCreated());
+			return _arena.view_folded(handle(a_form));
+		}
+
+	private:
+		[[nodiscard]] StringArena::handle_type handle(RE::TESForm& a_form)
+		{
+			const auto formID = a_form.GetFormID();
+			{
+				std::shared_lock l{ _lock };
+				if (const auto it = _names.find(formID); it != _names.end()) {
+					return it->second;
+				}
+			}
+
+			const auto name = Resolve(a_form);
+			std::unique_lock l{ _lock };
+			const auto [it, inserted] = _names.try_emplace(formID);
+			if (inserted) {
+				it->second = _arena.push_back_folded(name);
+			}
+			return it->second;
+		}
+
+		mutable std::shared_mutex _lock;
+		StringArena _arena;
+		robin_hood::unordered_flat_map<key_type, StringArena::handle_type> _names;
+	};
+
+	DisplayNameCache(const DisplayNameCache&) = delete;
+	DisplayNameCache(DisplayNameCache&&) = delete;
+
+	DisplayNameCache& operator=(const DisplayNameCache&) = delete;
+	DisplayNameCache& operator=(DisplayNameCache&&) = delete;
+
+	[[nodiscard]] static DisplayNameCache& get()
+	{
+		static DisplayNameCache singleton;
+		return singleton;
+	}
+
+	[[nodiscard]] static std::string_view Resolve(RE::TESForm& a_form)
+	{
+		auto displayName = RE::TESFullName::GetFullName(a_form, true);
+		if (displayName.empty()) {
+			const auto lvli = a_form.As<RE::TESLeveledList>();
+			displayName = lvli ? stl::safe_string(lvli->GetOverrideName()) : ""sv;
+		}
+		return displayName;
+	}
+
+	// readers keep the table they started with, so invalidating never pulls names out from under them
+	[[nodiscard]] std::shared_ptr<Table> table()
+	{
+		std::scoped_lock l{ _lock };
+		return _table;
+	}
+
+	// loading a save can rename forms, so the table is replaced whenever the game state changes hands
+	void invalidate()
+	{
+		auto table = std::make_shared<Table>();
+		std::scoped_lock l{ _lock };
+		_table = std::move(table);
+	}
+
+private:
+	DisplayNameCache() :
+		_table(std::make_shared<Table>())
+	{}
+
+	~DisplayNameCache() = default;
+
+	std::mutex _lock;
+	std::shared_ptr<Table> _table;
+};
@@ -1,5 +1,12 @@
 #pragma once
 
+#include "EditorIDFile.h"
+#include "FormHooks.h"
+#include "Metrics.h"
+#include "StringArena.h"
+#include "TrigramIndex.h"
+#include "Version.h"
+
 class EditorIDCache
 {
 public:
@@ -9,82 +16,217 @@ public:
 	{
 	public:
 		using key_type = std::uint32_t;
-		using mapped_type = std::string;
+		using mapped_type = std::string_view;
+
+		~Cache() = default;
 
-		[[nodiscard]] mapped_type* find(key_type a_key)
+		[[nodiscard]] std::optional<mapped_type> find(key_type a_key) const
 		{
 			const auto it = _formID2EditorID.find(a_key);
-			return it != _formID2EditorID.end() ? std::addressof(it->second) : nullptr;
+			return it != _formID2EditorID.cend() ? std::make_optional(_arena->view(it->second)) : std::nullopt;
 		}
 
-		[[nodiscard]] const mapped_type* find(key_type a_key) const
+		// only available if the cache was installed with case folding
+		[[nodiscard]] std::optional<mapped_type> find_folded(key_type a_key) const
 		{
+			if (!_folded) {
+				return std::nullopt;
+			}
+
 			const auto it = _formID2EditorID.find(a_key);
-			return it != _formID2EditorID.cend() ? std::addressof(it->second) : nullptr;
+			return it != _formID2EditorID.cend() ? std::make_optional(_arena->view_folded(it->second)) : std::nullopt;
+		}
+
+		// case insensitive, exact match
+		[[nodiscard]] std::optional<key_type> find(mapped_type a_editorID) const
+		{
+			const auto it = _editorID2FormID.find(a_editorID);
+			return it != _editorID2FormID.cend() ? std::make_optional(it->second) : std::nullopt;
 		}
 
-		bool insert(key_type a_key, mapped_type a_mapped)
+		// the sorted ids of every form of the given type with an editor id
+		[[nodiscard]] std::span<const key_type> bucket(RE::ENUM_FORM_ID a_type) const
 		{
-			return _formID2EditorID.insert_or_assign(a_key, std::move(a_mapped)).second;
+			std::call_once(_derived.bucketsOnce, [&]() {
+				auto& offsets = _derived.bucketOffsets;
+				offsets.assign(BUCKETS + 1, 0);
+				for (const auto& [formID, type] : _formTypes) {
+					++offsets[stl::to_underlying(type) + 1];
+				}
+				std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+				auto& ids = _derived.bucketIDs;
+				ids.resize(_formTypes.size());
+				auto next = offsets;
+				for (const auto& [formID, type] : _formTypes) {
+					ids[next[stl::to_underlying(type)]++] = formID;
+				}
+				for (std::size_t i = 0; i < BUCKETS; ++i) {
+					std::sort(ids.begin() + offsets[i], ids.begin() + offsets[i + 1]);
+				}
+			});
+
+			const auto i = static_cast<std::size_t>(stl::to_underlying(a_type));
+			if (i >= BUCKETS) {
+				return {};
+			}
+
+			const auto& offsets = _derived.bucketOffsets;
+			return { _derived.bucketIDs.data() + offsets[i], offsets[i + 1] - offsets[i] };
+		}
+
+		[[nodiscard]] std::uint64_t epoch() const noexcept { return _epoch; }
+		[[nodiscard]] bool folded() const noexcept { return _folded; }
+		[[nodiscard]] std::size_t size() const noexcept { return _formID2EditorID.size(); }
+
+		// the ids of every form with an editor id, in no particular order
+		[[nodiscard]] std::vector<key_type> keys() const
+		{
+			std::vector<key_type> result;
+			result.reserve(_formID2EditorID.size());
+			for (const auto& [formID, handle] : _formID2EditorID) {
+				result.push_back(formID);
+			}
+			return result;
 		}
 
-		bool insert(key_type a_key, std::string_view a_mapped)
+		// a published epoch never changes, so its index is built once on first use
+		[[nodiscard]] const TrigramIndex& trigrams() const
 		{
-			return _formID2EditorID.insert_or_assign(a_key, a_mapped).second;
+			std::call_once(_derived.once, [&]() {
+				for (const auto& [formID, handle] : _formID2EditorID) {
+					_derived.trigrams.insert(formID, _arena->view(handle));
+				}
+				_derived.trigrams.build();
+			});
+			return _derived.trigrams;
 		}
 
 	protected:
 		friend class EditorIDCache;
 
-		Cache() = default;
+		Cache(StringArena& a_arena) noexcept :
+			_arena(std::addressof(a_arena))
+		{}
+
 		Cache(const Cache&) = default;
 		Cache(Cache&&) = default;
 
-		~Cache() = default;
-
 		Cache& operator=(const Cache&) = default;
 		Cache& operator=(Cache&&) = default;
 
-	private:
-		robin_hood::unordered_flat_map<key_type, mapped_type> _formID2EditorID;
-	};
+		bool insert(key_type a_key, mapped_type a_mapped, RE::ENUM_FORM_ID a_type)
+		{
+			if (const auto [type, inserted] = _formTypes.try_emplace(a_key, a_type);
+				inserted || type->second != a_type) {
+				type->second = a_type;
+				++_epoch;
+			}
 
-	class Accessor
-	{
-	public:
-		using value_type = Cache;
+			const auto it = _formID2EditorID.find(a_key);
+			if (it != _formID2EditorID.end()) {
+				// plugin overrides usually repeat the same editor id, so don't grow the arena for them
+				if (_arena->view(it->second) != a_mapped) {
+					unindex(a_key, it->second);
+					it->second = push_back(a_mapped);
+					index(a_key, it->second);
+					++_epoch;
+				}
+				return false;
+			} else {
+				restore(a_key, push_back(a_mapped));
+				return true;
+			}
+		}
 
-		Accessor() = delete;
-		Accessor(const Accessor&) = delete;
-		Accessor(Accessor&&) = delete;
+		// inserts a handle which already lives in the arena
+		void restore(key_type a_key, StringArena::handle_type a_handle, std::optional<RE::ENUM_FORM_ID> a_type)
+		{
+			if (a_type) {
+				_formTypes.insert_or_assign(a_key, *a_type);
+			}
 
-		~Accessor() = default;
+			restore(a_key, a_handle);
+		}
 
-		Accessor& operator=(const Accessor&) = delete;
-		Accessor& operator=(Accessor&&) = delete;
+		void restore(key_type a_key, StringArena::handle_type a_handle)
+		{
+			const auto [it, inserted] = _formID2EditorID.try_emplace(a_key, a_handle);
+			if (!inserted) {
+				unindex(a_key, it->second);
+				it->second = a_handle;
+			}
+			index(a_key, a_handle);
+			++_epoch;
+		}
+
+		void erase(key_type a_key)
+		{
+			const auto it = _formID2EditorID.find(a_key);
+			if (it != _formID2EditorID.end()) {
+				unindex(a_key, it->second);
+				_formID2EditorID.erase(it);
+				++_epoch;
+			}
+			_formTypes.erase(a_key);
+		}
+
+	private:
+		static constexpr auto BUCKETS = static_cast<std::size_t>(stl::to_underlying(RE::ENUM_FORM_ID::kTotal));
 
-		[[nodiscard]] value_type& operator*() noexcept { return get(); }
-		[[nodiscard]] const value_type& operator*() const noexcept { return get(); }
+		[[nodiscard]] StringArena::handle_type push_back(mapped_type a_mapped)
+		{
+			return _folded ? _arena->push_back_folded(a_mapped) : _arena->push_back(a_mapped);
+		}
 
-		[[nodiscard]] value_type* operator->() noexcept { return std::addressof(get()); }
-		[[nodiscard]] const value_type* operator->() const noexcept { return std::addressof(get()); }
+		// state derived from an epoch, which is never carried over into the next one
+		struct Derived
+		{
+		public:
+			Derived() = default;
+			Derived(const Derived&) noexcept {}
+			Derived(Derived&&) noexcept {}
 
-		[[nodiscard]] value_type& get() noexcept { return _proxy; }
-		[[nodiscard]] const value_type& get() const noexcept { return _proxy; }
+			~Derived() = default;
 
-	protected:
-		friend class EditorIDCache;
+			Derived& operator=(const Derived&) noexcept { return *this; }
+			Derived& operator=(Derived&&) noexcept { return *this; }
 
-		Accessor(lock_type& a_lock, value_type& a_cache) :
-			_locker(a_lock),
-			_proxy(a_cache)
-		{}
+			std::once_flag once;
+			TrigramIndex trigrams;
+			std::once_flag bucketsOnce;
+			std::vector<key_type> bucketIDs;
+			std::vector<std::uint32_t> bucketOffsets;
+		};
 
-	private:
-		std::scoped_lock<lock_type> _locker;
-		value_type& _proxy;
+		void index(key_type a_key, StringArena::handle_type a_handle)
+		{
+			if (const auto editorID = _arena->view(a_handle); !editorID.empty()) {
+				_editorID2FormID.insert_or_assign(editorID, a_key);
+			}
+		}
+
+		void unindex(key_type a_key, StringArena::handle_type a_handle)
+		{
+			const auto it = _editorID2FormID.find(_arena->view(a_handle));
+			if (it != _editorID2FormID.end() && it->second == a_key) {
+				_editorID2FormID.erase(it);
+			}
+		}
+
+		// editor ids are interned into the arena shared by every epoch, so copying the cache only copies handles
+		StringArena* _arena;
+		robin_hood::unordered_flat_map<key_type, StringArena::handle_type> _formID2EditorID;
+		robin_hood::unordered_flat_map<mapped_type, key_type, stl::cistring_hash, stl::cistring_equal_to> _editorID2FormID;
+		robin_hood::unordered_flat_map<key_type, RE::ENUM_FORM_ID> _formTypes;  // restored with the editor ids, and confirmed by the hooks
+		std::uint64_t _epoch{ 0 };
+		bool _folded{ false };
+		mutable Derived _derived;
 	};
 
+	// an immutable view of the cache, safe to read without holding any lock
+	using snapshot_type = std::shared_ptr<const Cache>;
+
 	EditorIDCache(const EditorIDCache&) = delete;
 	EditorIDCache(EditorIDCache&&) = delete;
 
@@ -97,195 +239,249 @@ public:
 		return singleton;
 	}
 
-	[[nodiscard]] Accessor access() { return { _lock, _cache }; }
+	[[nodiscard]] snapshot_type snapshot()
+	{
+		if (!_dirty.load(std::memory_order_acquire)) {
+			return _snapshot.load(std::memory_order_acquire);
+		} else {
+			return publish();
+		}
+	}
+
+	bool insert(Cache::key_type a_key, std::string_view a_mapped, RE::ENUM_FORM_ID a_type)
+	{
+		const auto l = lock();
+		const auto epoch = _staging.epoch();
+		const auto result = _staging.insert(a_key, a_mapped, a_type);
+		if (_staging.epoch() != epoch) {
+			_dirty.store(true, std::memory_order_release);
+		}
+		if (!_unconfirmed.empty()) {
+			_unconfirmed.erase(a_key);
+		}
+		return result;
+	}
+
+	// drops restored entries which were never confirmed by a hook this session, and writes the
+	// cache back out if it differs from what was restored
+	// must be called once all plugins have finished loading
+	void sync()
+	{
+		const auto fingerprint = LoadOrderFingerprint();
+		if (_restored && _restored->fingerprint != fingerprint) {
+			logger::info("load order changed since the editor id cache was written"sv);
+		}
+
+		std::unique_lock l{ _lock };
+		for (const auto formID : _unconfirmed) {
+			_staging.erase(formID);
+		}
+		decltype(_unconfirmed)().swap(_unconfirmed);
+		_dirty.store(true, std::memory_order_release);
+
+		if (!_restored ||
+			_restored->fingerprint != fingerprint ||
+			_restored->epoch != _staging.epoch()) {
+			save(fingerprint);
+		}
+
+		logger::info(
+			"editor id cache holds {} entries in {} KiB of strings ({} KiB allocated)"sv,
+			_staging.size(),
+			_arena.size() >> 10,
+			_arena.capacity() >> 10);
+	}
 
-	void install()
+	// case folding stores a lowercase copy of every editor id, trading memory for faster searches
+	void install(bool a_foldCase)
 	{
-		Hook<RE::TESForm>::Install();
-		Hook<RE::TESObject>::Install();
-		Hook<RE::TESBoundObject>::Install();
-		Hook<RE::MagicItem>::Install();
-		Hook<RE::TESBoundAnimObject>::Install();
-		Hook<RE::TESActorBase>::Install();
-		Hook<RE::BGSStoryManagerTreeForm>::Install();
-		Hook<RE::BGSStoryManagerNodeBase>::Install();
-		Hook<RE::BGSKeyword>::Install();
-		Hook<RE::BGSLocationRefType>::Install();
-		Hook<RE::BGSAction>::Install();
-		Hook<RE::BGSTransform>::Install();
-		Hook<RE::BGSComponent>::Install();
-		Hook<RE::BGSTextureSet>::Install();
-		Hook<RE::BGSMenuIcon>::Install();
-		Hook<RE::TESGlobal>::Install();
-		Hook<RE::BGSDamageType>::Install();
-		Hook<RE::TESClass>::Install();
-		Hook<RE::TESFaction>::Install();
-		Hook<RE::BGSHeadPart>::Install();
-		Hook<RE::TESEyes>::Install();
-		Hook<RE::TESRace>::Install();
-		Hook<RE::TESSound>::Install();
-		Hook<RE::BGSAcousticSpace>::Install();
-		Hook<RE::EffectSetting>::Install();
-		Hook<RE::Script>::Install();
-		Hook<RE::TESLandTexture>::Install();
-		Hook<RE::EnchantmentItem>::Install();
-		Hook<RE::SpellItem>::Install();
-		Hook<RE::ScrollItem>::Install();
-		Hook<RE::TESObjectACTI>::Install();
-		Hook<RE::BGSTalkingActivator>::Install();
-		Hook<RE::TESObjectARMO>::Install();
-		Hook<RE::TESObjectBOOK>::Install();
-		Hook<RE::TESObjectCONT>::Install();
-		Hook<RE::TESObjectDOOR>::Install();
-		Hook<RE::IngredientItem>::Install();
-		Hook<RE::TESObjectLIGH>::Install();
-		Hook<RE::TESObjectMISC>::Install();
-		Hook<RE::TESObjectSTAT>::Install();
-		Hook<RE::BGSStaticCollection>::Install();
-		Hook<RE::BGSMovableStatic>::Install();
-		Hook<RE::TESGrass>::Install();
-		Hook<RE::TESObjectTREE>::Install();
-		Hook<RE::TESFlora>::Install();
-		Hook<RE::TESFurniture>::Install();
-		Hook<RE::TESObjectWEAP>::Install();
-		Hook<RE::TESAmmo>::Install();
-		Hook<RE::TESNPC>::Install();
-		Hook<RE::TESLevCharacter>::Install();
-		Hook<RE::TESKey>::Install();
-		Hook<RE::AlchemyItem>::Install();
-		Hook<RE::BGSIdleMarker>::Install();
-		Hook<RE::BGSNote>::Install();
-		Hook<RE::BGSProjectile>::Install();
-		Hook<RE::BGSHazard>::Install();
-		Hook<RE::BGSBendableSpline>::Install();
-		Hook<RE::TESSoulGem>::Install();
-		Hook<RE::BGSTerminal>::Install();
-		Hook<RE::TESLevItem>::Install();
-		Hook<RE::TESWeather>::Install();
-		Hook<RE::TESClimate>::Install();
-		Hook<RE::BGSShaderParticleGeometryData>::Install();
-		Hook<RE::BGSReferenceEffect>::Install();
-		Hook<RE::TESRegion>::Install();
-		Hook<RE::NavMeshInfoMap>::Install();
-		Hook<RE::TESObjectCELL>::Install();
-		Hook<RE::TESObjectREFR>::Install();
-		Hook<RE::Explosion>::Install();
-		Hook<RE::Projectile>::Install();
-		Hook<RE::Actor>::Install();
-		Hook<RE::PlayerCharacter>::Install();
-		Hook<RE::MissileProjectile>::Install();
-		Hook<RE::ArrowProjectile>::Install();
-		Hook<RE::GrenadeProjectile>::Install();
-		Hook<RE::BeamProjectile>::Install();
-		Hook<RE::FlameProjectile>::Install();
-		Hook<RE::ConeProjectile>::Install();
-		Hook<RE::BarrierProjectile>::Install();
-		Hook<RE::Hazard>::Install();
-		Hook<RE::TESWorldSpace>::Install();
-		Hook<RE::TESObjectLAND>::Install();
-		Hook<RE::NavMesh>::Install();
-		Hook<RE::TESTopic>::Install();
-		Hook<RE::TESTopicInfo>::Install();
-		Hook<RE::TESQuest>::Install();
-		Hook<RE::TESIdleForm>::Install();
-		Hook<RE::TESPackage>::Install();
-		Hook<RE::AlarmPackage>::Install();
-		Hook<RE::DialoguePackage>::Install();
-		Hook<RE::FleePackage>::Install();
-		Hook<RE::SpectatorPackage>::Install();
-		Hook<RE::TrespassPackage>::Install();
-		Hook<RE::TESCombatStyle>::Install();
-		Hook<RE::TESLoadScreen>::Install();
-		Hook<RE::TESLevSpell>::Install();
-		Hook<RE::TESObjectANIO>::Install();
-		Hook<RE::TESWaterForm>::Install();
-		Hook<RE::TESEffectShader>::Install();
-		Hook<RE::BGSExplosion>::Install();
-		Hook<RE::BGSDebris>::Install();
-		Hook<RE::TESImageSpace>::Install();
-		Hook<RE::TESImageSpaceModifier>::Install();
-		Hook<RE::BGSListForm>::Install();
-		Hook<RE::BGSPerk>::Install();
-		Hook<RE::BGSBodyPartData>::Install();
-		Hook<RE::BGSAddonNode>::Install();
-		Hook<RE::ActorValueInfo>::Install();
-		Hook<RE::BGSCameraShot>::Install();
-		Hook<RE::BGSCameraPath>::Install();
-		Hook<RE::BGSVoiceType>::Install();
-		Hook<RE::BGSMaterialType>::Install();
-		Hook<RE::BGSImpactData>::Install();
-		Hook<RE::BGSImpactDataSet>::Install();
-		Hook<RE::TESObjectARMA>::Install();
-		Hook<RE::BGSEncounterZone>::Install();
-		Hook<RE::BGSLocation>::Install();
-		Hook<RE::BGSMessage>::Install();
-		Hook<RE::BGSDefaultObjectManager>::Install();
-		Hook<RE::BGSDefaultObject>::Install();
-		Hook<RE::BGSLightingTemplate>::Install();
-		Hook<RE::BGSMusicType>::Install();
-		Hook<RE::BGSFootstep>::Install();
-		Hook<RE::BGSFootstepSet>::Install();
-		Hook<RE::BGSStoryManagerBranchNode>::Install();
-		Hook<RE::BGSStoryManagerQuestNode>::Install();
-		Hook<RE::BGSStoryManagerEventNode>::Install();
-		Hook<RE::BGSDialogueBranch>::Install();
-		Hook<RE::BGSMusicTrackFormWrapper>::Install();
-		Hook<RE::TESWordOfPower>::Install();
-		Hook<RE::TESShout>::Install();
-		Hook<RE::BGSEquipSlot>::Install();
-		Hook<RE::BGSRelationship>::Install();
-		Hook<RE::BGSScene>::Install();
-		Hook<RE::BGSAssociationType>::Install();
-		Hook<RE::BGSOutfit>::Install();
-		Hook<RE::BGSArtObject>::Install();
-		Hook<RE::BGSMaterialObject>::Install();
-		Hook<RE::BGSMovementType>::Install();
-		Hook<RE::BGSSoundDescriptorForm>::Install();
-		Hook<RE::BGSDualCastData>::Install();
-		Hook<RE::BGSSoundCategory>::Install();
-		Hook<RE::BGSSoundOutput>::Install();
-		Hook<RE::BGSCollisionLayer>::Install();
-		Hook<RE::BGSColorForm>::Install();
-		Hook<RE::BGSReverbParameters>::Install();
-		Hook<RE::BGSPackIn>::Install();
-		Hook<RE::BGSAimModel>::Install();
-		Hook<RE::BGSConstructibleObject>::Install();
-		Hook<RE::BGSMod::Attachment::Mod>::Install();
-		Hook<RE::BGSMaterialSwap>::Install();
-		Hook<RE::BGSZoomData>::Install();
-		Hook<RE::BGSInstanceNamingRules>::Install();
-		Hook<RE::BGSSoundKeywordMapping>::Install();
-		Hook<RE::BGSAudioEffectChain>::Install();
-		Hook<RE::BGSAttractionRule>::Install();
-		Hook<RE::BGSSoundCategorySnapshot>::Install();
-		Hook<RE::BGSSoundTagSet>::Install();
-		Hook<RE::BGSLensFlare>::Install();
-		Hook<RE::BGSGodRays>::Install();
+		_staging._folded = a_foldCase;
+		load();
+
+		Hooks::Install("editor id"sv);
 
 		logger::debug("installed hooks for {}"sv, typeid(EditorIDCache).name());
 	}
 
 private:
-	EditorIDCache() = default;
+	EditorIDCache() :
+		_staging(_arena),
+		_snapshot(snapshot_type{ new Cache(_arena) })
+	{}
+
 	~EditorIDCache() = default;
 
+	struct Restored
+	{
+	public:
+		std::uint64_t fingerprint{ 0 };
+		std::uint64_t epoch{ 0 };
+	};
+
+	[[nodiscard]] static std::uint64_t LoadOrderFingerprint()
+	{
+		std::uint64_t hash = EditorIDFile::Checksum({});
+		const auto dataHandler = RE::TESDataHandler::GetSingleton();
+		if (dataHandler) {
+			const auto files = stl::make_array(
+				std::span{ dataHandler->compiledFileCollection.files.begin(), dataHandler->compiledFileCollection.files.size() },
+				std::span{ dataHandler->compiledFileCollection.smallFiles.begin(), dataHandler->compiledFileCollection.smallFiles.size() });
+			for (const auto& list : files) {
+				for (const auto file : list) {
+					const auto filename = file ? file->GetFilename() : ""sv;
+					hash = EditorIDFile::Checksum({ filename.data(), filename.size() }, hash);
+					hash = EditorIDFile::Checksum({ "\0", 1 }, hash);
+				}
+				hash = EditorIDFile::Checksum({ "\0", 1 }, hash);
+			}
+		}
+		return hash;
+	}
+
+	// the cache alternates between two slots, since the one in use stays mapped for the whole session
+	[[nodiscard]] static std::optional<std::filesystem::path> CachePath(std::size_t a_slot)
+	{
+		auto path = logger::log_directory();
+		if (path) {
+			*path /= fmt::format(FMT_STRING("{}.{}.cache"), Version::PROJECT, a_slot);
+		}
+		return path;
+	}
+
+	// maps the newest valid cache written by a previous session, and seeds the staging cache with it
+	void load()
+	{
+		std::array<std::pair<std::filesystem::file_time_type, std::size_t>, 2> slots;
+		for (std::size_t i = 0; i < slots.size(); ++i) {
+			const auto path = CachePath(i);
+			std::error_code ec;
+			slots[i] = { path ? std::filesystem::last_write_time(*path, ec) : std::filesystem::file_time_type::min(), i };
+			if (ec) {
+				slots[i].first = std::filesystem::file_time_type::min();
+			}
+		}
+		std::sort(slots.rbegin(), slots.rend());
+
+		for (const auto& [time, slot] : slots) {
+			if (time != std::filesystem::file_time_type::min() && load(slot)) {
+				return;
+			}
+		}
+	}
+
+	bool load(std::size_t a_slot)
+	{
+		const auto path = CachePath(a_slot);
+		try {
+			_mapping.open(path->string());
+		} catch (const std::exception& e) {
+			logger::warn("failed to map editor id cache: {}"sv, e.what());
+			return false;
+		}
+
+		const auto file = EditorIDFile::Read({ _mapping.data(), _mapping.size() });
+		if (!file) {
+			logger::warn("discarding corrupt editor id cache {}"sv, path->string());
+			_mapping.close();
+			return false;
+		} else if (file->folded() != _staging._folded) {
+			logger::info("discarding editor id cache {} written with different options"sv, path->string());
+			_mapping.close();
+			return false;
+		}
+
+		_arena.adopt(file->strings());
+
+		std::scoped_lock l{ _lock };
+		_unconfirmed.reserve(file->size());
+		for (std::size_t i = 0; i < file->size(); ++i) {
+			if (const auto record = file->record(i); record) {
+				const auto type = record->formType < stl::to_underlying(RE::ENUM_FORM_ID::kTotal) ?
+                                      std::make_optional(static_cast<RE::ENUM_FORM_ID>(record->formType)) :
+                                      std::nullopt;
+				_staging.restore(record->formID, record->handle, type);
+				_unconfirmed.insert(record->formID);
+			}
+		}
+
+		_restored = Restored{ file->header().fingerprint, _staging.epoch() };
+		_slot = a_slot;
+		_dirty.store(true, std::memory_order_release);
+		logger::info("restored {} editor ids from {}"sv, _staging.size(), path->string());
+		return true;
+	}
+
+	// writes the staging cache out in a layout which can be adopted as-is by an empty arena
+	// the caller must hold the lock
+	void save(std::uint64_t a_fingerprint) const
+	{
+		const auto path = CachePath(_slot ^ 1);
+		if (!path) {
+			return;
+		}
+
+		std::vector<EditorIDFile::Record> records;
+		records.reserve(_staging._formID2EditorID.size());
+		for (const auto& [formID, handle] : _staging._formID2EditorID) {
+			const auto type = _staging._formTypes.find(formID);
+			records.push_back({
+				formID,
+				handle,
+				type != _staging._formTypes.end() ? stl::to_underlying(type->second) : EditorIDFile::Record::UNKNOWN_TYPE,
+			});
+		}
+
+		if (EditorIDFile::Write(*path, a_fingerprint, _staging._folded, records, _arena)) {
+			logger::info("wrote {} editor ids to {}"sv, records.size(), path->string());
+		}
+	}
+
+	// the time spent waiting on the lock is measured, since the hooks and publishing contend on it
+	[[nodiscard]] std::unique_lock<lock_type> lock()
+	{
+		const Metrics::Timer timer{ Metrics::Metric::kCacheLockWait };
+		return std::unique_lock{ _lock };
+	}
+
+	// writers only ever touch the staging cache, so publishing a new epoch is the only time they
+	// contend with readers, and only for as long as it takes to copy the staging cache
+	[[nodiscard]] snapshot_type publish()
+	{
+		const auto l = lock();
+		if (_dirty.load(std::memory_order_relaxed)) {
+			_snapshot.store(snapshot_type{ new Cache(_staging) }, std::memory_order_release);
+			_dirty.store(false, std::memory_order_release);
+		}
+		return _snapshot.load(std::memory_order_acquire);
+	}
+
 	template <class T>
 	class Hook
 	{
 	public:
-		static void Install()
+		[[nodiscard]] static std::uintptr_t slot()
 		{
 			REL::Relocation<std::uintptr_t> vtable{ T::VTABLE[0] };
-			_original = vtable.write_vfunc(0x3B, SetFormEditorID);
+			return vtable.address() + 0x3B * sizeof(std::uintptr_t);
+		}
+
+		// the slot's page must already be writable
+		static void attach(std::uintptr_t a_slot)
+		{
+			auto& vfunc = *reinterpret_cast<std::uintptr_t*>(a_slot);
+			_original = vfunc;
+			vfunc = reinterpret_cast<std::uintptr_t>(SetFormEditorID);
 		}
 
 	private:
 		static bool SetFormEditorID(RE::TESForm* a_this, const char* a_editorID)
 		{
 			if (a_this && !a_this->IsCreated()) {
-				EditorIDCache::get().access()->insert(
+				const Metrics::Timer timer{ Metrics::Metric::kSetFormEditorID };
+				EditorIDCache::get().insert(
 					a_this->GetFormID(),
-					stl::safe_string(a_editorID));
+					stl::safe_string(a_editorID),
+					a_this->GetFormType());
 			}
 
 			return _original(a_this, a_editorID);
@@ -294,6 +490,15 @@ private:
 		static inline REL::Relocation<decltype(&RE::TESForm::SetFormEditorID)> _original;
 	};
 
+	using Hooks = FormHooks<Hook>;
+
+	boost::iostreams::mapped_file_source _mapping;  // must outlive the arena
 	lock_type _lock;
-	Cache _cache;
+	StringArena _arena;
+	Cache _staging;
+	std::atomic_bool _dirty{ false };
+	std::atomic<snapshot_type> _snapshot;
+	robin_hood::unordered_flat_set<Cache::key_type> _unconfirmed;
+	std::optional<Restored> _restored;
+	std::size_t _slot{ 1 };
 };
@@ -0,0 +1,182 @@
+#pragma once
+
+#include "StringArena.h"
+
+// the on-disk layout of the editor id cache, kept apart from the game so it can be written and validated anywhere
+// a file is a header, the records sorted by form id, then the strings laid out so an empty arena can adopt them as-is
+class EditorIDFile
+{
+public:
+	struct Header
+	{
+	public:
+		enum Flag : std::uint32_t
+		{
+			kNone = 0,
+			kFolded = 1 << 0
+		};
+
+		static constexpr std::array<char, 4> MAGIC{ 'C', 'C', 'E', 'I' };
+		static constexpr std::uint32_t VERSION = 3;
+
+		std::array<char, 4> magic{ MAGIC };
+		std::uint32_t version{ VERSION };
+		std::uint64_t fingerprint{ 0 };
+		std::uint64_t checksum{ 0 };
+		std::uint32_t count{ 0 };
+		std::uint32_t stringsSize{ 0 };
+		std::uint32_t flags{ kNone };
+		std::uint32_t pad24{ 0 };
+	};
+	static_assert(sizeof(Header) == 0x28);
+
+	struct Record
+	{
+	public:
+		static constexpr std::uint8_t UNKNOWN_TYPE = 0xFF;
+
+		std::uint32_t formID{ 0 };
+		StringArena::handle_type handle;
+		std::uint8_t formType{ UNKNOWN_TYPE };  // so forms confirmed with the type they were written with don't start a new epoch
+		std::uint8_t pad0D{ 0 };
+		std::uint16_t pad0E{ 0 };
+	};
+	static_assert(sizeof(Record) == 0x10);
+
+	// a file which passed validation, still backed by the bytes it was read from
+	class View
+	{
+	public:
+		[[nodiscard]] const Header& header() const noexcept { return _header; }
+		[[nodiscard]] bool folded() const noexcept { return (_header.flags & Header::kFolded) != 0; }
+		[[nodiscard]] std::size_t size() const noexcept { return _header.count; }
+		[[nodiscard]] std::span<const char> strings() const noexcept { return _strings; }
+
+		// records whose strings don't lie within the file are skipped
+		[[nodiscard]] std::optional<Record> record(std::size_t a_index) const noexcept
+		{
+			Record record;
+			std::memcpy(std::addressof(record), _records.data() + a_index * sizeof(Record), sizeof(Record));
+			const std::size_t copies = folded() ? 2 : 1;
+			return std::size_t{ record.handle.offset } + record.handle.length * copies <= _strings.size() ?
+                       std::make_optional(record) :
+                       std::nullopt;
+		}
+
+	protected:
+		friend class EditorIDFile;
+
+		View() noexcept = default;
+
+	private:
+		Header _header;
+		std::span<const char> _records;
+		std::span<const char> _strings;
+	};
+
+	[[nodiscard]] static std::uint64_t Checksum(std::span<const char> a_bytes, std::uint64_t a_hash = 14695981039346656037ull) noexcept
+	{
+		for (const auto byte : a_bytes) {  // fnv1a
+			a_hash ^= static_cast<unsigned char>(byte);
+			a_hash *= 1099511628211ull;
+		}
+		return a_hash;
+	}
+
+	[[nodiscard]] static std::optional<View> Read(std::span<const char> a_bytes)
+	{
+		if (a_bytes.size() < sizeof(Header)) {
+			return std::nullopt;
+		}
+
+		View view;
+		auto& header = view._header;
+		std::memcpy(std::addressof(header), a_bytes.data(), sizeof(Header));
+		if (header.magic != Header::MAGIC ||
+			header.version != Header::VERSION ||
+			a_bytes.size() != sizeof(Header) + std::size_t{ header.count } * sizeof(Record) + header.stringsSize ||
+			header.checksum != Checksum(a_bytes.subspan(sizeof(Header)))) {
+			return std::nullopt;
+		}
+
+		view._records = a_bytes.subspan(sizeof(Header), std::size_t{ header.count } * sizeof(Record));
+		view._strings = a_bytes.subspan(sizeof(Header) + view._records.size());
+		return view;
+	}
+
+	// rewrites the handles in the given records to point into the file, and replaces the file at the given path
+	// a string never straddles a chunk boundary, and strings larger than a chunk get chunks of their own
+	static bool Write(
+		const std::filesystem::path& a_path,
+		std::uint64_t a_fingerprint,
+		bool a_folded,
+		std::vector<Record>& a_records,
+		const StringArena& a_arena)
+	{
+		std::sort(
+			a_records.begin(),
+			a_records.end(),
+			[](auto&& a_lhs, auto&& a_rhs) noexcept {
+				return a_lhs.formID < a_rhs.formID;
+			});
+
+		const std::size_t copies = a_folded ? 2 : 1;
+		std::vector<char> strings;
+		const auto align = [&]() {
+			if (const auto pos = strings.size() % StringArena::CHUNK_SIZE; pos != 0) {
+				strings.resize(strings.size() + (StringArena::CHUNK_SIZE - pos), '\0');
+			}
+		};
+		for (auto& record : a_records) {
+			const auto editorID = a_arena.view(record.handle);
+			const auto size = editorID.length() * copies;
+			if (StringArena::CHUNK_SIZE - strings.size() % StringArena::CHUNK_SIZE < size) {
+				align();
+			}
+
+			const auto offset = static_cast<StringArena::size_type>(strings.size());
+			strings.insert(strings.end(), editorID.begin(), editorID.end());
+			if (a_folded) {
+				const auto folded = a_arena.view_folded(record.handle);
+				strings.insert(strings.end(), folded.begin(), folded.end());
+			}
+			record.handle.offset = offset;
+
+			if (size > StringArena::CHUNK_SIZE) {
+				align();
+			}
+		}
+
+		Header header;
+		header.fingerprint = a_fingerprint;
+		header.count = static_cast<std::uint32_t>(a_records.size());
+		header.stringsSize = static_cast<std::uint32_t>(strings.size());
+		header.flags = a_folded ? Header::kFolded : Header::kNone;
+		header.checksum = Checksum(
+			{ strings.data(), strings.size() },
+			Checksum({ reinterpret_cast<const char*>(a_records.data()), a_records.size() * sizeof(Record) }));
+
+		auto tmp = a_path;
+		tmp += ".tmp"sv;
+		{
+			std::ofstream file{ tmp, std::ios::binary | std::ios::trunc };
+			file.write(reinterpret_cast<const char*>(std::addressof(header)), sizeof(header));
+			file.write(reinterpret_cast<const char*>(a_records.data()), a_records.size() * sizeof(Record));
+			file.write(strings.data(), strings.size());
+			if (!file) {
+				logger::warn("failed to write editor id cache to {}"sv, tmp.string());
+				return false;
+			}
+		}
+
+		std::error_code ec;
+		std::filesystem::rename(tmp, a_path, ec);
+		if (ec) {
+			logger::warn("failed to replace editor id cache: {}"sv, ec.message());
+			std::filesystem::remove(tmp, ec);
+			return false;
+		}
+
+		return true;
+	}
+};
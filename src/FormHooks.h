@@ -0,0 +1,233 @@
+#pragma once
+
+// patches one slot in the vtable of every listed class with Hook<T>, whose slot() returns the address of the slot,
+// and whose attach() swaps the hook in and keeps the original
+// every vtable is resolved before anything is written, and the slots are then patched a page at a time
+// vtables sit next to each other in .rdata, so each page's protection only changes once for all the slots it holds
+template <template <class> class Hook, class... Ts>
+class HookList
+{
+public:
+	static void Install(std::string_view a_name) { Install(a_name, std::index_sequence_for<Ts...>{}); }
+
+private:
+	static constexpr std::uintptr_t PAGE_SIZE = 0x1000;
+
+	template <std::size_t... I>
+	static void Install(std::string_view a_name, std::index_sequence<I...>)
+	{
+		const auto start = std::chrono::steady_clock::now();
+
+		const std::array slots{ Hook<Ts>::slot()... };
+		std::vector<std::pair<std::uintptr_t, std::uint32_t>> pages;  // page, original protection
+		pages.reserve(slots.size());
+		for (const auto slot : slots) {
+			pages.emplace_back(slot & ~(PAGE_SIZE - 1), 0);
+		}
+		std::sort(pages.begin(), pages.end());
+		pages.erase(
+			std::unique(
+				pages.begin(),
+				pages.end(),
+				[](auto&& a_lhs, auto&& a_rhs) noexcept {
+					return a_lhs.first == a_rhs.first;
+				}),
+			pages.end());
+
+		for (auto& [page, protect] : pages) {
+			if (!F4SE::WinAPI::VirtualProtect(
+					reinterpret_cast<void*>(page),
+					PAGE_SIZE,
+					F4SE::WinAPI::PAGE_EXECUTE_READWRITE,
+					std::addressof(protect))) {
+				stl::report_and_fail("failed to unprotect vtable page"sv);
+			}
+		}
+
+		(Hook<Ts>::attach(slots[I]), ...);
+
+		for (const auto& [page, protect] : pages) {
+			std::uint32_t old = 0;
+			if (!F4SE::WinAPI::VirtualProtect(
+					reinterpret_cast<void*>(page),
+					PAGE_SIZE,
+					protect,
+					std::addressof(old))) {
+				logger::warn("failed to restore the protection of vtable page {:X}"sv, page);
+			}
+		}
+
+		const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+		logger::info(
+			"installed {} {} hooks across {} pages in {} us"sv,
+			slots.size(),
+			a_name,
+			pages.size(),
+			elapsed.count());
+	}
+};
+
+// every form class, which between them own every vtable a form can have
+template <template <class> class Hook>
+using FormHooks = HookList<
+	Hook,
+	RE::TESForm,
+	RE::TESObject,
+	RE::TESBoundObject,
+	RE::MagicItem,
+	RE::TESBoundAnimObject,
+	RE::TESActorBase,
+	RE::BGSStoryManagerTreeForm,
+	RE::BGSStoryManagerNodeBase,
+	RE::BGSKeyword,
+	RE::BGSLocationRefType,
+	RE::BGSAction,
+	RE::BGSTransform,
+	RE::BGSComponent,
+	RE::BGSTextureSet,
+	RE::BGSMenuIcon,
+	RE::TESGlobal,
+	RE::BGSDamageType,
+	RE::TESClass,
+	RE::TESFaction,
+	RE::BGSHeadPart,
+	RE::TESEyes,
+	RE::TESRace,
+	RE::TESSound,
+	RE::BGSAcousticSpace,
+	RE::EffectSetting,
+	RE::Script,
+	RE::TESLandTexture,
+	RE::EnchantmentItem,
+	RE::SpellItem,
+	RE::ScrollItem,
+	RE::TESObjectACTI,
+	RE::BGSTalkingActivator,
+	RE::TESObjectARMO,
+	RE::TESObjectBOOK,
+	RE::TESObjectCONT,
+	RE::TESObjectDOOR,
+	RE::IngredientItem,
+	RE::TESObjectLIGH,
+	RE::TESObjectMISC,
+	RE::TESObjectSTAT,
+	RE::BGSStaticCollection,
+	RE::BGSMovableStatic,
+	RE::TESGrass,
+	RE::TESObjectTREE,
+	RE::TESFlora,
+	RE::TESFurniture,
+	RE::TESObjectWEAP,
+	RE::TESAmmo,
+	RE::TESNPC,
+	RE::TESLevCharacter,
+	RE::TESKey,
+	RE::AlchemyItem,
+	RE::BGSIdleMarker,
+	RE::BGSNote,
+	RE::BGSProjectile,
+	RE::BGSHazard,
+	RE::BGSBendableSpline,
+	RE::TESSoulGem,
+	RE::BGSTerminal,
+	RE::TESLevItem,
+	RE::TESWeather,
+	RE::TESClimate,
+	RE::BGSShaderParticleGeometryData,
+	RE::BGSReferenceEffect,
+	RE::TESRegion,
+	RE::NavMeshInfoMap,
+	RE::TESObjectCELL,
+	RE::TESObjectREFR,
+	RE::Explosion,
+	RE::Projectile,
+	RE::Actor,
+	RE::PlayerCharacter,
+	RE::MissileProjectile,
+	RE::ArrowProjectile,
+	RE::GrenadeProjectile,
+	RE::BeamProjectile,
+	RE::FlameProjectile,
+	RE::ConeProjectile,
+	RE::BarrierProjectile,
+	RE::Hazard,
+	RE::TESWorldSpace,
+	RE::TESObjectLAND,
+	RE::NavMesh,
+	RE::TESTopic,
+	RE::TESTopicInfo,
+	RE::TESQuest,
+	RE::TESIdleForm,
+	RE::TESPackage,
+	RE::AlarmPackage,
+	RE::DialoguePackage,
+	RE::FleePackage,
+	RE::SpectatorPackage,
+	RE::TrespassPackage,
+	RE::TESCombatStyle,
+	RE::TESLoadScreen,
+	RE::TESLevSpell,
+	RE::TESObjectANIO,
+	RE::TESWaterForm,
+	RE::TESEffectShader,
+	RE::BGSExplosion,
+	RE::BGSDebris,
+	RE::TESImageSpace,
+	RE::TESImageSpaceModifier,
+	RE::BGSListForm,
+	RE::BGSPerk,
+	RE::BGSBodyPartData,
+	RE::BGSAddonNode,
+	RE::ActorValueInfo,
+	RE::BGSCameraShot,
+	RE::BGSCameraPath,
+	RE::BGSVoiceType,
+	RE::BGSMaterialType,
+	RE::BGSImpactData,
+	RE::BGSImpactDataSet,
+	RE::TESObjectARMA,
+	RE::BGSEncounterZone,
+	RE::BGSLocation,
+	RE::BGSMessage,
+	RE::BGSDefaultObjectManager,
+	RE::BGSDefaultObject,
+	RE::BGSLightingTemplate,
+	RE::BGSMusicType,
+	RE::BGSFootstep,
+	RE::BGSFootstepSet,
+	RE::BGSStoryManagerBranchNode,
+	RE::BGSStoryManagerQuestNode,
+	RE::BGSStoryManagerEventNode,
+	RE::BGSDialogueBranch,
+	RE::BGSMusicTrackFormWrapper,
+	RE::TESWordOfPower,
+	RE::TESShout,
+	RE::BGSEquipSlot,
+	RE::BGSRelationship,
+	RE::BGSScene,
+	RE::BGSAssociationType,
+	RE::BGSOutfit,
+	RE::BGSArtObject,
+	RE::BGSMaterialObject,
+	RE::BGSMovementType,
+	RE::BGSSoundDescriptorForm,
+	RE::BGSDualCastData,
+	RE::BGSSoundCategory,
+	RE::BGSSoundOutput,
+	RE::BGSCollisionLayer,
+	RE::BGSColorForm,
+	RE::BGSReverbParameters,
+	RE::BGSPackIn,
+	RE::BGSAimModel,
+	RE::BGSConstructibleObject,
+	RE::BGSMod::Attachment::Mod,
+	RE::BGSMaterialSwap,
+	RE::BGSZoomData,
+	RE::BGSInstanceNamingRules,
+	RE::BGSSoundKeywordMapping,
+	RE::BGSAudioEffectChain,
+	RE::BGSAttractionRule,
+	RE::BGSSoundCategorySnapshot,
+	RE::BGSSoundTagSet,
+	RE::BGSLensFlare,
+	RE::BGSGodRays>;
@@ -1,42 +1,28 @@
 #pragma once
 
-class FormTypeMap
+// a bijection between form types and their four character record signatures, resolved entirely at compile time
+namespace FormTypeMap
 {
-public:
 	using string_type = std::string_view;
 	using enum_type = RE::ENUM_FORM_ID;
 
-	FormTypeMap(const FormTypeMap&) = delete;
-	FormTypeMap(FormTypeMap&&) = delete;
-
-	FormTypeMap& operator=(const FormTypeMap&) = delete;
-	FormTypeMap& operator=(FormTypeMap&&) = delete;
-
-	[[nodiscard]] static FormTypeMap& get()
+	namespace detail
 	{
-		static FormTypeMap singleton;
-		return singleton;
-	}
+		inline constexpr auto TOTAL = static_cast<std::size_t>(stl::to_underlying(RE::ENUM_FORM_ID::kTotal));
 
-	[[nodiscard]] std::optional<enum_type> find(string_type a_key) const
-	{
-		assert(a_key.length() == 4);
-		const auto it = _str2Enum.find(a_key);
-		return it != _str2Enum.end() ? std::make_optional(it->second) : std::nullopt;
-	}
-
-	[[nodiscard]] std::optional<string_type> find(enum_type a_key) const
-	{
-		const auto it = _enum2Str.find(a_key);
-		return it != _enum2Str.end() ? std::make_optional(it->second) : std::nullopt;
-	}
+		// signatures are exactly four characters, so they pack losslessly into a single integer
+		[[nodiscard]] constexpr std::uint32_t pack(string_type a_key) noexcept
+		{
+			std::uint32_t result = 0;
+			for (const auto ch : a_key) {
+				result = (result << 8) | static_cast<unsigned char>(ch);
+			}
+			return result;
+		}
 
-private:
-	FormTypeMap()
-	{
 #define ELEMENT(a_elem) std::make_pair(#a_elem##sv, RE::ENUM_FORM_ID::k##a_elem)
 
-		constexpr std::array seeds{
+		inline constexpr std::array SEEDS{
 			ELEMENT(NONE),
 			ELEMENT(TES4),
 			ELEMENT(GRUP),
@@ -196,23 +182,62 @@ private:
 			ELEMENT(LSPR),
 			ELEMENT(GDRY),
 			ELEMENT(OVIS),
+		};
 
 #undef ELEMENT
-		};
 
-		static_assert(seeds.size() == stl::to_underlying(RE::ENUM_FORM_ID::kTotal));
+		// indexed by form type
+		inline constexpr auto ENUM_TO_STRING = []() noexcept {
+			std::array<string_type, TOTAL> result{};
+			for (const auto& [str, type] : SEEDS) {
+				result[static_cast<std::size_t>(stl::to_underlying(type))] = str;
+			}
+			return result;
+		}();
 
-		for (const auto& seed : seeds) {
-			_str2Enum.emplace(seed.first, seed.second);
-			_enum2Str.emplace(seed.second, seed.first);
+		// sorted by packed signature
+		inline constexpr auto STRING_TO_ENUM = []() noexcept {
+			std::array<std::pair<std::uint32_t, enum_type>, TOTAL> result{};
+			for (std::size_t i = 0; i < SEEDS.size(); ++i) {
+				result[i] = { pack(SEEDS[i].first), SEEDS[i].second };
+			}
+			std::sort(result.begin(), result.end());
+			return result;
+		}();
+
+		static_assert(SEEDS.size() == TOTAL);
+		static_assert(std::all_of(SEEDS.begin(), SEEDS.end(), [](auto&& a_elem) { return a_elem.first.length() == 4; }));
+		static_assert(std::none_of(ENUM_TO_STRING.begin(), ENUM_TO_STRING.end(), [](auto&& a_elem) { return a_elem.empty(); }));
+		static_assert(std::adjacent_find(
+						  STRING_TO_ENUM.begin(),
+						  STRING_TO_ENUM.end(),
+						  [](auto&& a_lhs, auto&& a_rhs) { return a_lhs.first == a_rhs.first; }) == STRING_TO_ENUM.end());
+	}
+
+	[[nodiscard]] constexpr std::optional<enum_type> find(string_type a_key) noexcept
+	{
+		if (a_key.length() != 4) {
+			return std::nullopt;
 		}
 
-		assert(_str2Enum.size() == stl::to_underlying(RE::ENUM_FORM_ID::kTotal));
-		assert(_enum2Str.size() == stl::to_underlying(RE::ENUM_FORM_ID::kTotal));
+		const auto key = detail::pack(a_key);
+		const auto it = std::lower_bound(
+			detail::STRING_TO_ENUM.begin(),
+			detail::STRING_TO_ENUM.end(),
+			key,
+			[](auto&& a_lhs, auto&& a_rhs) noexcept {
+				return a_lhs.first < a_rhs;
+			});
+		return it != detail::STRING_TO_ENUM.end() && it->first == key ? std::make_optional(it->second) : std::nullopt;
 	}
 
-	~FormTypeMap() = default;
+	[[nodiscard]] constexpr std::optional<string_type> find(enum_type a_key) noexcept
+	{
+		const auto i = static_cast<std::size_t>(stl::to_underlying(a_key));
+		return i < detail::ENUM_TO_STRING.size() ? std::make_optional(detail::ENUM_TO_STRING[i]) : std::nullopt;
+	}
 
-	robin_hood::unordered_flat_map<string_type, enum_type> _str2Enum;
-	robin_hood::unordered_flat_map<enum_type, string_type> _enum2Str;
-};
+	static_assert(find("WEAP"sv) == RE::ENUM_FORM_ID::kWEAP);
+	static_assert(find(RE::ENUM_FORM_ID::kWEAP) == "WEAP"sv);
+	static_assert(!find("weap"sv));
+}
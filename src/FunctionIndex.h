@@ -0,0 +1,127 @@
+#pragma once
+
+#include "StringArena.h"
+
+// case folded names of the console and script functions, in table order and sorted for exact lookups
+// the tables are only rewritten while plugins load, so the index is built then, before the console can run a query
+class FunctionIndex
+{
+public:
+	struct Function
+	{
+	public:
+		RE::SCRIPT_FUNCTION* function{ nullptr };
+		std::string_view functionName;  // folded
+		std::string_view shortName;     // folded
+	};
+
+	class Table
+	{
+	public:
+		Table() = default;
+		Table(const Table&) = delete;
+		Table(Table&&) = delete;
+
+		~Table() = default;
+
+		Table& operator=(const Table&) = delete;
+		Table& operator=(Table&&) = delete;
+
+		[[nodiscard]] std::span<const Function> functions() const noexcept { return { _functions.data(), _functions.size() }; }
+
+		// long names take precedence over short names which happen to collide with them
+		[[nodiscard]] RE::SCRIPT_FUNCTION* find(std::string_view a_name) const
+		{
+			std::string folded{ a_name };
+			for (auto& ch : folded) {
+				ch = stl::tolower(ch);
+			}
+
+			const auto it = std::lower_bound(
+				_sorted.begin(),
+				_sorted.end(),
+				std::string_view{ folded },
+				[](auto&& a_lhs, auto&& a_rhs) noexcept {
+					return a_lhs.name < a_rhs;
+				});
+			return it != _sorted.end() && it->name == folded ? _functions[it->index].function : nullptr;
+		}
+
+		void build(std::span<RE::SCRIPT_FUNCTION> a_functions, StringArena& a_names)
+		{
+			_functions.clear();
+			_sorted.clear();
+
+			_functions.reserve(a_functions.size());
+			for (auto& function : a_functions) {
+				const auto index = static_cast<std::uint32_t>(_functions.size());
+				auto& elem = _functions.emplace_back(Function{ std::addressof(function) });
+				if (const auto name = stl::safe_string(function.functionName); !name.empty()) {
+					elem.functionName = a_names.view_folded(a_names.push_back_folded(name));
+					_sorted.push_back({ elem.functionName, false, index });
+				}
+				if (const auto name = stl::safe_string(function.shortName); !name.empty()) {
+					elem.shortName = a_names.view_folded(a_names.push_back_folded(name));
+					_sorted.push_back({ elem.shortName, true, index });
+				}
+			}
+
+			std::stable_sort(
+				_sorted.begin(),
+				_sorted.end(),
+				[](auto&& a_lhs, auto&& a_rhs) noexcept {
+					return a_lhs.name != a_rhs.name ?
+                               a_lhs.name < a_rhs.name :
+                               a_lhs.shortName < a_rhs.shortName;
+				});
+		}
+
+	private:
+		struct Entry
+		{
+		public:
+			std::string_view name;
+			bool shortName{ false };
+			std::uint32_t index{ 0 };
+		};
+
+		std::vector<Function> _functions;
+		std::vector<Entry> _sorted;
+	};
+
+	FunctionIndex(const FunctionIndex&) = delete;
+	FunctionIndex(FunctionIndex&&) = delete;
+
+	FunctionIndex& operator=(const FunctionIndex&) = delete;
+	FunctionIndex& operator=(FunctionIndex&&) = delete;
+
+	[[nodiscard]] static FunctionIndex& get()
+	{
+		static FunctionIndex singleton;
+		return singleton;
+	}
+
+	[[nodiscard]] const Table& console() const noexcept { return _console; }
+	[[nodiscard]] const Table& script() const noexcept { return _script; }
+
+	void build()
+	{
+		_names = std::make_unique<StringArena>();
+		_console.build(RE::SCRIPT_FUNCTION::GetConsoleFunctions(), *_names);
+		_script.build(RE::SCRIPT_FUNCTION::GetScriptFunctions(), *_names);
+
+		logger::debug(
+			"indexed {} console and {} script functions"sv,
+			_console.functions().size(),
+			_script.functions().size());
+	}
+
+private:
+	FunctionIndex() = default;
+
+	~FunctionIndex() = default;
+
+	std::unique_ptr<StringArena> _names;
+	Table _console;
+	Table _script;
+};
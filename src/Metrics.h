@@ -0,0 +1,234 @@
+#pragma once
+
+// call counts and latency histograms for the plugin's hot paths
+// every thread records into a shard of its own, so an event costs two clock reads and a handful of uncontended stores
+class Metrics
+{
+public:
+	using clock_type = std::chrono::steady_clock;
+
+	enum class Metric : std::uint32_t
+	{
+		kSetFormEditorID,
+		kCacheLockWait,
+		kHelpSnapshot,
+		kHelpGather,
+		kHelpMatch,
+		kHelpSort,
+		kHelpPrint,
+
+		kTotal
+	};
+
+	static constexpr auto METRICS = static_cast<std::size_t>(Metric::kTotal);
+	static constexpr std::size_t BUCKETS = 32;  // bucket i counts events which took less than 2^i ns, the last one is open ended
+
+	struct Summary
+	{
+	public:
+		std::uint64_t count{ 0 };
+		std::uint64_t nanoseconds{ 0 };
+		std::array<std::uint64_t, BUCKETS> histogram{};
+	};
+
+	class Timer
+	{
+	public:
+		explicit Timer(Metric a_metric) noexcept :
+			_metric(a_metric),
+			_start(clock_type::now())
+		{}
+
+		Timer(const Timer&) = delete;
+		Timer(Timer&&) = delete;
+
+		~Timer()
+		{
+			const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - _start);
+			Metrics::record(_metric, static_cast<std::uint64_t>(elapsed.count()));
+		}
+
+		Timer& operator=(const Timer&) = delete;
+		Timer& operator=(Timer&&) = delete;
+
+	private:
+		Metric _metric;
+		clock_type::time_point _start;
+	};
+
+	Metrics(const Metrics&) = delete;
+	Metrics(Metrics&&) = delete;
+
+	Metrics& operator=(const Metrics&) = delete;
+	Metrics& operator=(Metrics&&) = delete;
+
+	[[nodiscard]] static Metrics& get()
+	{
+		static Metrics singleton;
+		return singleton;
+	}
+
+	static void record(Metric a_metric, std::uint64_t a_nanoseconds)
+	{
+		// only the owning thread writes to a shard, so plain loads and stores are enough to keep the counts exact
+		const auto bump = [](std::atomic_uint64_t& a_value, std::uint64_t a_delta) noexcept {
+			a_value.store(a_value.load(std::memory_order_relaxed) + a_delta, std::memory_order_relaxed);
+		};
+
+		auto& slot = local().slots[static_cast<std::size_t>(a_metric)];
+		bump(slot.count, 1);
+		bump(slot.nanoseconds, a_nanoseconds);
+		bump(slot.histogram[std::min<std::size_t>(std::bit_width(a_nanoseconds), BUCKETS - 1)], 1);
+	}
+
+	[[nodiscard]] std::array<Summary, METRICS> collect() const
+	{
+		std::scoped_lock l{ _lock };
+		auto result = _retired;
+		for (const auto shard : _shards) {
+			shard->merge(result);
+		}
+		return result;
+	}
+
+	[[nodiscard]] std::string format() const
+	{
+		std::string result;
+		const auto summaries = collect();
+		for (std::size_t i = 0; i < summaries.size(); ++i) {
+			const auto& summary = summaries[i];
+			if (summary.count == 0) {
+				continue;
+			}
+
+			fmt::format_to(
+				std::back_inserter(result),
+				FMT_STRING("{}: {} calls, {} us total, {} ns mean, p50 < {} ns, p99 < {} ns\n"),
+				NAMES[i],
+				summary.count,
+				summary.nanoseconds / 1000,
+				summary.nanoseconds / summary.count,
+				percentile(summary, 50),
+				percentile(summary, 99));
+		}
+		return result;
+	}
+
+	// periodically writes the current numbers to the log, if anything was recorded since the last time
+	// the thread is never joined, it's torn down with the process
+	void start(std::chrono::seconds a_interval)
+	{
+		std::thread([a_interval]() {
+			std::uint64_t last = 0;
+			for (;;) {
+				std::this_thread::sleep_for(a_interval);
+
+				const auto& self = Metrics::get();
+				std::uint64_t total = 0;
+				for (const auto& summary : self.collect()) {
+					total += summary.count;
+				}
+
+				if (total != last) {
+					last = total;
+					logger::info("metrics:\n{}"sv, self.format());
+				}
+			}
+		}).detach();
+	}
+
+private:
+	static constexpr std::array<std::string_view, METRICS> NAMES{
+		"SetFormEditorID"sv,
+		"EditorIDCache lock wait"sv,
+		"Help snapshot"sv,
+		"Help gather"sv,
+		"Help match"sv,
+		"Help sort"sv,
+		"Help print"sv,
+	};
+
+	struct Slot
+	{
+	public:
+		std::atomic_uint64_t count{ 0 };
+		std::atomic_uint64_t nanoseconds{ 0 };
+		std::array<std::atomic_uint64_t, BUCKETS> histogram{};
+	};
+
+	struct Shard
+	{
+	public:
+		void merge(std::array<Summary, METRICS>& a_dst) const noexcept
+		{
+			for (std::size_t i = 0; i < slots.size(); ++i) {
+				auto& dst = a_dst[i];
+				const auto& src = slots[i];
+				dst.count += src.count.load(std::memory_order_relaxed);
+				dst.nanoseconds += src.nanoseconds.load(std::memory_order_relaxed);
+				for (std::size_t j = 0; j < BUCKETS; ++j) {
+					dst.histogram[j] += src.histogram[j].load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		std::array<Slot, METRICS> slots;
+	};
+
+	// a thread's shard is registered on its first event, and folded into the retired totals when the thread exits
+	class Local
+	{
+	public:
+		Local() { Metrics::get().attach(shard); }
+		Local(const Local&) = delete;
+		Local(Local&&) = delete;
+
+		~Local() { Metrics::get().detach(shard); }
+
+		Local& operator=(const Local&) = delete;
+		Local& operator=(Local&&) = delete;
+
+		Shard shard;
+	};
+
+	Metrics() = default;
+
+	~Metrics() = default;
+
+	[[nodiscard]] static Shard& local()
+	{
+		thread_local Local local;
+		return local.shard;
+	}
+
+	// the upper bound of the bucket holding the given percentile
+	[[nodiscard]] static std::uint64_t percentile(const Summary& a_summary, std::uint64_t a_percent) noexcept
+	{
+		const auto target = (a_summary.count * a_percent + 99) / 100;
+		std::uint64_t seen = 0;
+		for (std::size_t i = 0; i < BUCKETS; ++i) {
+			seen += a_summary.histogram[i];
+			if (seen >= target) {
+				return std::uint64_t{ 1 } << i;
+			}
+		}
+		return std::uint64_t{ 1 } << (BUCKETS - 1);
+	}
+
+	void attach(const Shard& a_shard)
+	{
+		std::scoped_lock l{ _lock };
+		_shards.push_back(std::addressof(a_shard));
+	}
+
+	void detach(const Shard& a_shard)
+	{
+		std::scoped_lock l{ _lock };
+		a_shard.merge(_retired);
+		std::erase(_shards, std::addressof(a_shard));
+	}
+
+	mutable std::mutex _lock;
+	std::vector<const Shard*> _shards;
+	std::array<Summary, METRICS> _retired{};
+};
@@ -0,0 +1,130 @@
+#pragma once
+
+// ascii case insensitive search for many needles at once, reporting which of them occur in the haystack
+// the needles are compiled into an aho-corasick automaton, so the haystack is walked exactly once no matter
+// how many needles there are, at the cost of one table lookup per character
+class MultiSubstringSearcher
+{
+public:
+	using mask_type = std::uint64_t;
+	using state_type = std::uint16_t;
+
+	static constexpr std::size_t MAX_NEEDLES = std::numeric_limits<mask_type>::digits;
+
+	MultiSubstringSearcher() = default;
+
+	// needle i is reported as bit i of the mask
+	explicit MultiSubstringSearcher(std::span<const std::string_view> a_needles)
+	{
+		assert(a_needles.size() <= MAX_NEEDLES);
+		build(a_needles);
+	}
+
+	MultiSubstringSearcher(const MultiSubstringSearcher&) = default;
+	MultiSubstringSearcher(MultiSubstringSearcher&&) = default;
+
+	~MultiSubstringSearcher() = default;
+
+	MultiSubstringSearcher& operator=(const MultiSubstringSearcher&) = default;
+	MultiSubstringSearcher& operator=(MultiSubstringSearcher&&) = default;
+
+	[[nodiscard]] bool empty() const noexcept { return _output.empty(); }
+
+	// the transitions carry both cases of every letter, so raw and pre-folded haystacks are searched alike
+	// a_done is called with the needles found so far whenever another one turns up, and stops the search by returning true
+	template <class F>
+	[[nodiscard]] mask_type operator()(std::string_view a_haystack, F&& a_done) const
+	{
+		if (empty()) {
+			return 0;
+		}
+
+		auto found = _output[ROOT];
+		if (found != 0 && a_done(found)) {
+			return found;
+		}
+
+		std::size_t state = ROOT;
+		for (const auto ch : a_haystack) {
+			state = _table[state * _width + _classes[static_cast<unsigned char>(ch)]];
+			if (const auto output = _output[state] & ~found; output != 0) {
+				found |= output;
+				if (a_done(found)) {
+					break;
+				}
+			}
+		}
+
+		return found;
+	}
+
+private:
+	static constexpr std::size_t ALPHABET = 0x100;
+	static constexpr state_type ROOT = 0;
+
+	void build(std::span<const std::string_view> a_needles)
+	{
+		// characters which appear in no needle all behave the same, so they share class 0 and the table stays narrow
+		std::size_t width = 1;
+		for (const auto needle : a_needles) {
+			for (const auto ch : needle) {
+				auto& elem = _classes[static_cast<unsigned char>(stl::tolower(ch))];
+				if (elem == 0) {
+					elem = static_cast<std::uint8_t>(width++);
+				}
+			}
+		}
+		for (unsigned char ch = 'a'; ch <= 'z'; ++ch) {
+			_classes[stl::toupper(static_cast<char>(ch))] = _classes[ch];
+		}
+		_width = width;
+
+		// the trie, where a transition to the root means there is no child yet
+		_table.assign(_width, ROOT);
+		_output.assign(1, 0);
+		for (std::size_t i = 0; i < a_needles.size(); ++i) {
+			std::size_t state = ROOT;
+			for (const auto ch : a_needles[i]) {
+				auto& next = _table[state * _width + _classes[static_cast<unsigned char>(ch)]];
+				if (next == ROOT) {
+					next = static_cast<state_type>(_output.size());
+					_table.resize(_table.size() + _width, ROOT);
+					_output.push_back(0);
+				}
+				state = _table[state * _width + _classes[static_cast<unsigned char>(ch)]];
+			}
+			_output[state] |= mask_type{ 1 } << i;
+		}
+
+		// breadth first, so every state's failure link is complete before its children need it
+		// missing transitions are then replaced with their failure link's, which turns the trie into a dfa
+		std::vector<state_type> failure(_output.size(), ROOT);
+		std::vector<state_type> queue;
+		queue.reserve(_output.size());
+		for (std::size_t c = 0; c < _width; ++c) {
+			if (const auto next = _table[c]; next != ROOT) {
+				queue.push_back(next);
+			}
+		}
+
+		for (std::size_t i = 0; i < queue.size(); ++i) {
+			const auto state = queue[i];
+			_output[state] |= _output[failure[state]];
+			for (std::size_t c = 0; c < _width; ++c) {
+				auto& next = _table[state * _width + c];
+				const auto fallback = _table[failure[state] * _width + c];
+				if (next != ROOT) {
+					failure[next] = fallback;
+					queue.push_back(next);
+				} else {
+					next = fallback;
+				}
+			}
+		}
+	}
+
+	std::array<std::uint8_t, ALPHABET> _classes{};
+	std::size_t _width{ 0 };
+	std::vector<state_type> _table;
+	std::vector<mask_type> _output;
+};
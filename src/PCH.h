@@ -5,22 +5,39 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <bit>
+#include <bitset>
+#include <chrono>
+#include <cstring>
 #include <execution>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <numeric>
 #include <optional>
+#include <shared_mutex>
 #include <span>
+#include <stop_token>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <tuple>
 #include <type_traits>
 #include <typeinfo>
+#include <unordered_set>
+#include <variant>
+
+#include <immintrin.h>
 
 #pragma warning(push)
-#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
-#include <boost/container/static_vector.hpp>
-#include <boost/container/vector.hpp>
-#include <boost/iterator/iterator_facade.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/property_tree/ini_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
 #include <robin_hood.h>
 
 #ifdef NDEBUG
@@ -80,60 +97,46 @@ namespace stl
 
 	[[nodiscard]] inline std::string_view safe_string(const char* a_str) noexcept { return a_str ? a_str : ""; }
 
-	class cistring_iterator :
-		public boost::iterator_facade<
-			cistring_iterator,
-			char,
-			std::random_access_iterator_tag,
-			char,
-			std::ptrdiff_t>
+	struct cistring_hash
 	{
-	private:
-		using super =
-			boost::iterator_facade<
-				cistring_iterator,
-				char,
-				std::random_access_iterator_tag,
-				char,
-				std::ptrdiff_t>;
-
-		using proxy_type = std::string_view::iterator;
-
 	public:
-		using iterator_category = typename super::iterator_category;
-		using value_type = typename super::value_type;
-		using difference_type = typename super::difference_type;
-		using pointer = typename super::pointer;
-		using reference = typename super::reference;
-
-		cistring_iterator(proxy_type a_proxy) noexcept :
-			_proxy(std::move(a_proxy))
-		{}
-
-		cistring_iterator() noexcept = default;
-		cistring_iterator(const cistring_iterator&) noexcept = default;
-		cistring_iterator(cistring_iterator&&) noexcept = default;
-
-		cistring_iterator& operator=(const cistring_iterator&) noexcept = default;
-		cistring_iterator& operator=(cistring_iterator&&) noexcept = default;
-
-	protected:
-		friend class boost::iterator_core_access;
-
-		reference dereference() const noexcept { return tolower(*_proxy); }
-
-		bool equal(const cistring_iterator& a_rhs) const noexcept { return _proxy == a_rhs._proxy; }
-
-		void increment() noexcept { ++_proxy; }
-
-		void decrement() noexcept { --_proxy; }
-
-		void advance(difference_type a_off) noexcept { _proxy += a_off; }
+		[[nodiscard]] std::size_t operator()(std::string_view a_string) const noexcept
+		{
+			std::uint64_t hash = 14695981039346656037ull;  // fnv1a
+			for (const auto ch : a_string) {
+				hash ^= static_cast<unsigned char>(tolower(ch));
+				hash *= 1099511628211ull;
+			}
+			return static_cast<std::size_t>(hash);
+		}
+	};
 
-		difference_type distance_to(const cistring_iterator& a_rhs) const noexcept { return a_rhs._proxy - _proxy; }
+	struct cistring_equal_to
+	{
+	public:
+		[[nodiscard]] bool operator()(std::string_view a_lhs, std::string_view a_rhs) const noexcept
+		{
+			return a_lhs.length() == a_rhs.length() &&
+			       std::equal(a_lhs.begin(), a_lhs.end(), a_rhs.begin(), [](char a_l, char a_r) noexcept {
+					   return tolower(a_l) == tolower(a_r);
+				   });
+		}
+	};
 
-	private:
-		proxy_type _proxy;
+	struct cistring_less
+	{
+	public:
+		[[nodiscard]] bool operator()(std::string_view a_lhs, std::string_view a_rhs) const noexcept
+		{
+			return std::lexicographical_compare(
+				a_lhs.begin(),
+				a_lhs.end(),
+				a_rhs.begin(),
+				a_rhs.end(),
+				[](char a_l, char a_r) noexcept {
+					return static_cast<unsigned char>(tolower(a_l)) < static_cast<unsigned char>(tolower(a_r));
+				});
+		}
 	};
 
 	template <class... Args>
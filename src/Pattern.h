@@ -0,0 +1,567 @@
+#pragma once
+
+// an ascii case insensitive glob or regular expression, compiled into a dfa which must match the entire haystack
+// the dfa carries transitions for both cases of every letter, so it runs over raw and pre-folded haystacks alike,
+// and matching is a single table lookup per character without any allocation
+//
+// globs support * and ?, and regular expressions support literals, ., [] classes with ranges and negation,
+// *, +, ?, {m}, {m,} and {m,n}, | and grouping, where \ only escapes a metacharacter, or - within a class
+class Pattern
+{
+public:
+	enum class Syntax
+	{
+		kGlob,
+		kRegex
+	};
+
+	using state_type = std::uint16_t;
+
+	static constexpr std::size_t MAX_STATES = 0x400;
+	static constexpr std::size_t MAX_WORK = 0x40000;  // nfa states visited while building the dfa, which bounds compile time
+
+	Pattern(const Pattern&) = delete;
+	Pattern(Pattern&&) = default;
+
+	~Pattern() = default;
+
+	Pattern& operator=(const Pattern&) = delete;
+	Pattern& operator=(Pattern&&) = default;
+
+	// returns nothing if the pattern is malformed, or too complex to compile
+	[[nodiscard]] static std::optional<Pattern> compile(std::string_view a_source, Syntax a_syntax)
+	{
+		std::string regex;
+		std::string literal;
+		if (a_syntax == Syntax::kGlob) {
+			// every run of plain characters in a glob must appear in any match, so the longest one can prune candidates
+			std::string run;
+			const auto flush = [&]() {
+				if (run.length() > literal.length()) {
+					literal = run;
+				}
+				run.clear();
+			};
+
+			for (const auto ch : a_source) {
+				switch (ch) {
+				case '*':
+					flush();
+					regex += ".*"sv;
+					break;
+				case '?':
+					flush();
+					regex += '.';
+					break;
+				default:
+					run += stl::tolower(ch);
+					if (METACHARACTERS.find(ch) != std::string_view::npos) {
+						regex += '\\';
+					}
+					regex += ch;
+					break;
+				}
+			}
+			flush();
+		} else {
+			regex = a_source;
+		}
+
+		Compiler compiler{ regex };
+		auto nfa = compiler.parse();
+		if (!nfa) {
+			return std::nullopt;
+		}
+
+		Pattern result;
+		result._literal = std::move(literal);
+		if (!result.build(compiler.states(), *nfa)) {
+			return std::nullopt;
+		}
+		return result;
+	}
+
+	// a string every match must contain, already case folded, or empty if there isn't one
+	[[nodiscard]] std::string_view literal() const noexcept { return _literal; }
+
+	[[nodiscard]] bool operator()(std::string_view a_haystack) const noexcept
+	{
+		state_type state = START;
+		for (const auto ch : a_haystack) {
+			state = _table[std::size_t{ state } * ALPHABET + static_cast<unsigned char>(ch)];
+			switch (_accept[state]) {
+			case Accept::kNever:
+				return false;
+			case Accept::kAlways:
+				return true;
+			default:
+				break;
+			}
+		}
+		return _accept[state] != Accept::kNever && _accept[state] != Accept::kNo;
+	}
+
+private:
+	static constexpr std::size_t ALPHABET = 0x100;
+	static constexpr auto METACHARACTERS = "\\.[]()|*+?^${}"sv;
+	static constexpr state_type DEAD = 0;
+	static constexpr state_type START = 1;
+
+	enum class Accept : std::uint8_t
+	{
+		kNo,      // rejects for now, but may still accept
+		kYes,     // accepts for now, but may still reject
+		kNever,   // rejects no matter what follows
+		kAlways,  // accepts no matter what follows
+	};
+
+	// thompson construction over a set of epsilon and character transitions
+	class Compiler
+	{
+	public:
+		struct State
+		{
+		public:
+			std::bitset<ALPHABET> chars;
+			std::uint32_t next{ 0 };  // only meaningful when chars is non-empty
+			std::vector<std::uint32_t> epsilon;
+		};
+
+		struct Fragment
+		{
+		public:
+			std::uint32_t start{ 0 };
+			std::uint32_t end{ 0 };
+		};
+
+		explicit Compiler(std::string_view a_source) noexcept :
+			_source(a_source)
+		{
+			// the dfa is always anchored at both ends, so explicit anchors are redundant
+			if (_source.starts_with('^')) {
+				_source.remove_prefix(1);
+			}
+			if (_source.ends_with('$') && !_source.ends_with("\\$"sv)) {
+				_source.remove_suffix(1);
+			}
+		}
+
+		[[nodiscard]] const std::vector<State>& states() const noexcept { return _states; }
+
+		[[nodiscard]] std::optional<Fragment> parse()
+		{
+			auto result = alternation();
+			return result && _pos == _source.length() ? result : std::nullopt;
+		}
+
+	private:
+		static constexpr std::size_t MAX_DEPTH = 0x40;
+		static constexpr std::size_t MAX_REPEAT = 0xFF;
+		static constexpr std::size_t MAX_NFA_STATES = 0x1000;
+
+		[[nodiscard]] std::uint32_t make()
+		{
+			_states.emplace_back();
+			return static_cast<std::uint32_t>(_states.size() - 1);
+		}
+
+		void link(std::uint32_t a_from, std::uint32_t a_to) { _states[a_from].epsilon.push_back(a_to); }
+
+		[[nodiscard]] Fragment make_chars(const std::bitset<ALPHABET>& a_chars)
+		{
+			const auto start = make();
+			const auto end = make();
+			_states[start].chars = a_chars;
+			_states[start].next = end;
+			return { start, end };
+		}
+
+		[[nodiscard]] static std::bitset<ALPHABET> fold(std::bitset<ALPHABET> a_chars) noexcept
+		{
+			for (std::size_t i = 0; i < ALPHABET; ++i) {
+				if (a_chars[i]) {
+					const auto ch = static_cast<char>(i);
+					a_chars.set(static_cast<unsigned char>(stl::tolower(ch)));
+					a_chars.set(static_cast<unsigned char>(stl::toupper(ch)));
+				}
+			}
+			return a_chars;
+		}
+
+		[[nodiscard]] bool done() const noexcept { return _pos >= _source.length(); }
+		[[nodiscard]] char peek() const noexcept { return _source[_pos]; }
+
+		[[nodiscard]] std::optional<Fragment> alternation()
+		{
+			if (++_depth > MAX_DEPTH) {
+				return std::nullopt;
+			}
+
+			auto lhs = concatenation();
+			while (lhs && !done() && peek() == '|') {
+				++_pos;
+				const auto rhs = concatenation();
+				if (!rhs) {
+					return std::nullopt;
+				}
+
+				const auto start = make();
+				const auto end = make();
+				link(start, lhs->start);
+				link(start, rhs->start);
+				link(lhs->end, end);
+				link(rhs->end, end);
+				lhs = Fragment{ start, end };
+			}
+
+			--_depth;
+			return lhs;
+		}
+
+		[[nodiscard]] std::optional<Fragment> concatenation()
+		{
+			const auto empty = make();
+			Fragment result{ empty, empty };
+			while (!done() && peek() != '|' && peek() != ')') {
+				const auto next = repetition();
+				if (!next) {
+					return std::nullopt;
+				}
+				link(result.end, next->start);
+				result.end = next->end;
+			}
+			return result;
+		}
+
+		[[nodiscard]] Fragment quantify(Fragment a_fragment, char a_op)
+		{
+			const auto start = make();
+			const auto end = make();
+			link(start, a_fragment.start);
+			link(a_fragment.end, end);
+			if (a_op != '+') {
+				link(start, end);
+			}
+			if (a_op != '?') {
+				link(a_fragment.end, a_fragment.start);
+			}
+			return { start, end };
+		}
+
+		[[nodiscard]] std::optional<Fragment> repetition()
+		{
+			// every state of the repeated fragment is made after this one, so bounds can copy them as a block
+			const auto first = static_cast<std::uint32_t>(_states.size());
+			auto result = atom();
+			while (result && !done() && (peek() == '*' || peek() == '+' || peek() == '?' || peek() == '{')) {
+				const auto op = _source[_pos++];
+				result = op == '{' ? bounds(first, *result) : quantify(*result, op);
+			}
+			return result;
+		}
+
+		[[nodiscard]] std::optional<std::size_t> number()
+		{
+			const auto begin = _pos;
+			std::size_t result = 0;
+			while (!done() && peek() >= '0' && peek() <= '9' && result <= MAX_REPEAT) {
+				result = result * 10 + static_cast<std::size_t>(_source[_pos++] - '0');
+			}
+			return _pos != begin && result <= MAX_REPEAT ? std::make_optional(result) : std::nullopt;
+		}
+
+		// x{m,n} is spelled out as m copies of x followed by n - m optional ones, or by x* if n is left out
+		[[nodiscard]] std::optional<Fragment> bounds(std::uint32_t a_first, Fragment a_fragment)
+		{
+			const auto min = number();
+			if (!min) {
+				return std::nullopt;
+			}
+
+			std::optional<std::size_t> max = min;
+			if (!done() && peek() == ',') {
+				++_pos;
+				max.reset();
+				if (!done() && peek() != '}') {
+					max = number();
+					if (!max || *max < *min) {
+						return std::nullopt;
+					}
+				}
+			}
+
+			if (done() || peek() != '}') {
+				return std::nullopt;
+			}
+			++_pos;
+
+			// every copy is taken before any of them is linked, since linking the original would leak into later copies
+			const auto last = static_cast<std::uint32_t>(_states.size());
+			const auto count = max ? *max : *min + 1;
+			if (count != 0 && _states.size() + (count - 1) * (last - a_first) > MAX_NFA_STATES) {
+				return std::nullopt;
+			}
+
+			std::vector<Fragment> copies;
+			copies.reserve(count);
+			for (std::size_t i = 0; i < count; ++i) {
+				if (i == 0) {
+					copies.push_back(a_fragment);
+					continue;
+				}
+
+				const auto offset = static_cast<std::uint32_t>(_states.size()) - a_first;
+				for (auto j = a_first; j < last; ++j) {
+					auto state = _states[j];
+					state.next += offset;
+					for (auto& next : state.epsilon) {
+						next += offset;
+					}
+					_states.push_back(std::move(state));
+				}
+				copies.push_back({ a_fragment.start + offset, a_fragment.end + offset });
+			}
+
+			const auto empty = make();
+			Fragment result{ empty, empty };
+			for (std::size_t i = 0; i < count; ++i) {
+				const auto next = i < *min ? copies[i] : quantify(copies[i], max ? '?' : '*');
+				link(result.end, next.start);
+				result.end = next.end;
+			}
+
+			return result;
+		}
+
+		[[nodiscard]] std::optional<Fragment> atom()
+		{
+			std::bitset<ALPHABET> chars;
+			switch (const auto ch = _source[_pos++]; ch) {
+			case '(':
+				{
+					const auto result = alternation();
+					if (!result || done() || peek() != ')') {
+						return std::nullopt;
+					}
+					++_pos;
+					return result;
+				}
+			case '[':
+				return bracket();
+			case '.':
+				chars.set();
+				return make_chars(chars);
+			case '\\':
+				if (done() || METACHARACTERS.find(peek()) == std::string_view::npos) {
+					return std::nullopt;
+				}
+				chars.set(static_cast<unsigned char>(_source[_pos++]));
+				return make_chars(fold(chars));
+			case '*':
+			case '+':
+			case '?':
+			case '{':
+			case '}':
+			case ')':
+				return std::nullopt;
+			default:
+				chars.set(static_cast<unsigned char>(ch));
+				return make_chars(fold(chars));
+			}
+		}
+
+		[[nodiscard]] std::optional<Fragment> bracket()
+		{
+			std::bitset<ALPHABET> chars;
+			const auto negate = !done() && peek() == '^';
+			if (negate) {
+				++_pos;
+			}
+
+			const auto unescape = [&](char& a_ch) {
+				if (a_ch != '\\') {
+					return true;
+				} else if (done() || (METACHARACTERS.find(peek()) == std::string_view::npos && peek() != '-')) {
+					return false;
+				}
+				a_ch = _source[_pos++];
+				return true;
+			};
+
+			// a leading ] is a literal, as is a - at either end
+			bool first = true;
+			while (!done() && (peek() != ']' || first)) {
+				first = false;
+				auto lo = _source[_pos++];
+				if (!unescape(lo)) {
+					return std::nullopt;
+				}
+
+				auto hi = lo;
+				if (_pos + 1 < _source.length() && peek() == '-' && _source[_pos + 1] != ']') {
+					hi = _source[_pos + 1];
+					_pos += 2;
+					if (!unescape(hi)) {
+						return std::nullopt;
+					}
+				}
+
+				const auto lower = static_cast<unsigned char>(lo);
+				const auto upper = static_cast<unsigned char>(hi);
+				if (lower > upper) {
+					return std::nullopt;
+				}
+				for (auto i = std::size_t{ lower }; i <= upper; ++i) {
+					chars.set(i);
+				}
+			}
+
+			if (done()) {
+				return std::nullopt;
+			}
+			++_pos;
+
+			chars = fold(chars);
+			if (negate) {
+				chars.flip();
+			}
+			return make_chars(chars);
+		}
+
+		std::string_view _source;
+		std::size_t _pos{ 0 };
+		std::size_t _depth{ 0 };
+		std::vector<State> _states;
+	};
+
+	Pattern() = default;
+
+	// subset construction, where each dfa state is the epsilon closure of a set of nfa states
+	[[nodiscard]] bool build(const std::vector<Compiler::State>& a_nfa, Compiler::Fragment a_fragment)
+	{
+		using set_type = std::vector<std::uint32_t>;
+
+		// stamped with the closure which last saw them, so nothing has to be cleared between closures
+		std::vector<std::uint32_t> seen(a_nfa.size());
+		std::uint32_t generation = 0;
+		std::vector<std::uint32_t> stack;
+		std::size_t work = 0;
+		const auto closure = [&](set_type& a_set) {
+			++generation;
+			stack.assign(a_set.begin(), a_set.end());
+			a_set.clear();
+			while (!stack.empty()) {
+				++work;
+				const auto state = stack.back();
+				stack.pop_back();
+				if (seen[state] != generation) {
+					seen[state] = generation;
+					a_set.push_back(state);
+					stack.insert(stack.end(), a_nfa[state].epsilon.begin(), a_nfa[state].epsilon.end());
+				}
+			}
+			std::sort(a_set.begin(), a_set.end());
+		};
+
+		std::map<set_type, state_type> ids;
+		std::vector<set_type> sets;
+		const auto intern = [&](set_type&& a_set) -> std::optional<state_type> {
+			work += a_set.size();  // looking a set up compares it against a few others
+			if (const auto it = ids.find(a_set); it != ids.end()) {
+				return it->second;
+			} else if (sets.size() >= MAX_STATES) {
+				return std::nullopt;
+			}
+
+			const auto id = static_cast<state_type>(sets.size());
+			ids.emplace(a_set, id);
+			sets.push_back(std::move(a_set));
+			return id;
+		};
+
+		set_type start{ a_fragment.start };
+		closure(start);
+		[[maybe_unused]] const auto dead = intern({});
+		[[maybe_unused]] const auto first = intern(std::move(start));
+		assert(dead == DEAD && first == START);
+
+		// bytes which no nfa state tells apart share a class, so each dfa state only works out one transition per class
+		std::array<std::uint16_t, ALPHABET> classes{};
+		std::vector<std::uint8_t> representatives{ 0 };
+		{
+			std::unordered_set<std::bitset<ALPHABET>> split;
+			for (const auto& state : a_nfa) {
+				if (state.chars.none() || !split.insert(state.chars).second) {
+					continue;
+				}
+
+				std::array<std::uint16_t, ALPHABET * 2> remap;
+				remap.fill(0xFFFF);
+				representatives.clear();
+				for (std::size_t ch = 0; ch < ALPHABET; ++ch) {
+					auto& id = remap[classes[ch] * std::size_t{ 2 } + (state.chars[ch] ? 1 : 0)];
+					if (id == 0xFFFF) {
+						id = static_cast<std::uint16_t>(representatives.size());
+						representatives.push_back(static_cast<std::uint8_t>(ch));
+					}
+					classes[ch] = id;
+				}
+			}
+		}
+
+		std::vector<state_type> transitions(representatives.size());
+		for (std::size_t i = 0; i < sets.size(); ++i) {
+			for (std::size_t c = 0; c < representatives.size(); ++c) {
+				work += sets[i].size();
+				if (work > MAX_WORK) {
+					return false;
+				}
+
+				set_type next;
+				for (const auto state : sets[i]) {
+					if (a_nfa[state].chars[representatives[c]]) {
+						next.push_back(a_nfa[state].next);
+					}
+				}
+				if (next.empty()) {
+					transitions[c] = DEAD;
+					continue;
+				}
+
+				closure(next);
+				const auto id = intern(std::move(next));
+				if (!id) {
+					return false;
+				}
+				transitions[c] = *id;
+			}
+
+			_table.resize((i + 1) * ALPHABET);
+			for (std::size_t ch = 0; ch < ALPHABET; ++ch) {
+				_table[i * ALPHABET + ch] = transitions[classes[ch]];
+			}
+		}
+
+		_accept.resize(sets.size(), Accept::kNo);
+		for (std::size_t i = 0; i < sets.size(); ++i) {
+			const auto accepts = std::binary_search(sets[i].begin(), sets[i].end(), a_fragment.end);
+			const auto loops = std::all_of(
+				_table.begin() + i * ALPHABET,
+				_table.begin() + (i + 1) * ALPHABET,
+				[&](state_type a_next) noexcept {
+					return a_next == i;
+				});
+			if (loops) {
+				_accept[i] = accepts ? Accept::kAlways : Accept::kNever;
+			} else {
+				_accept[i] = accepts ? Accept::kYes : Accept::kNo;
+			}
+		}
+
+		return true;
+	}
+
+	std::vector<state_type> _table;
+	std::vector<Accept> _accept;
+	std::string _literal;
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+// user options, read once at load from Data/F4SE/Plugins/<project>.ini
+// a missing file or key leaves the default in place
+class Settings
+{
+public:
+	Settings(const Settings&) = delete;
+	Settings(Settings&&) = delete;
+
+	Settings& operator=(const Settings&) = delete;
+	Settings& operator=(Settings&&) = delete;
+
+	[[nodiscard]] static Settings& get()
+	{
+		static Settings singleton;
+		return singleton;
+	}
+
+	// keeps a lowercase copy of every editor id, trading memory for faster searches
+	[[nodiscard]] bool foldCase() const noexcept { return _foldCase; }
+
+	void load()
+	{
+		const auto path = fmt::format(FMT_STRING("Data/F4SE/Plugins/{}.ini"), Version::PROJECT);
+		if (std::error_code ec; !std::filesystem::exists(path, ec)) {
+			return;
+		}
+
+		boost::property_tree::ptree ini;
+		try {
+			boost::property_tree::read_ini(path, ini);
+		} catch (const std::exception& e) {
+			logger::warn("failed to read {}: {}"sv, path, e.what());
+			return;
+		}
+
+		// read_ini keeps anything after the = verbatim, so a trailing comment makes the value unparsable
+		if (const auto value = ini.get_optional<std::string>("EditorIDCache.bFoldCase"); value) {
+			if (const auto parsed = ParseBool(*value); parsed) {
+				_foldCase = *parsed;
+			} else {
+				logger::warn("ignoring bFoldCase = \"{}\", which is neither true, false, 1 nor 0"sv, *value);
+			}
+		}
+		logger::info("bFoldCase = {}"sv, _foldCase);
+	}
+
+private:
+	Settings() = default;
+
+	[[nodiscard]] static std::optional<bool> ParseBool(std::string_view a_value) noexcept
+	{
+		const auto equals = [&](std::string_view a_rhs) {
+			return std::equal(a_value.begin(), a_value.end(), a_rhs.begin(), a_rhs.end(), [](char a_lhs, char a_rhs) noexcept {
+				return stl::tolower(a_lhs) == a_rhs;
+			});
+		};
+
+		if (equals("true"sv) || equals("1"sv)) {
+			return true;
+		} else if (equals("false"sv) || equals("0"sv)) {
+			return false;
+		} else {
+			return std::nullopt;
+		}
+	}
+
+	~Settings() = default;
+
+	bool _foldCase{ true };
+};
@@ -0,0 +1,121 @@
+#pragma once
+
+// an append-only string pool, carved out of large fixed size chunks
+// strings are never moved once written, so views into the arena remain valid for its lifetime
+class StringArena
+{
+public:
+	using size_type = std::uint32_t;
+
+	struct handle_type
+	{
+	public:
+		size_type offset{ 0 };
+		size_type length{ 0 };
+	};
+
+	static constexpr size_type CHUNK_SHIFT = 20;
+	static constexpr size_type CHUNK_SIZE = 1u << CHUNK_SHIFT;
+	static constexpr size_type MAX_CHUNKS = 1u << (std::numeric_limits<size_type>::digits - CHUNK_SHIFT);
+
+	StringArena() = default;
+	StringArena(const StringArena&) = delete;
+	StringArena(StringArena&&) = delete;
+
+	~StringArena() = default;
+
+	StringArena& operator=(const StringArena&) = delete;
+	StringArena& operator=(StringArena&&) = delete;
+
+	[[nodiscard]] std::string_view view(handle_type a_handle) const noexcept
+	{
+		const auto chunk = a_handle.offset >> CHUNK_SHIFT;
+		const auto pos = a_handle.offset & (CHUNK_SIZE - 1);
+		assert(chunk < _chunks.size() && _chunks[chunk]);
+		return { _chunks[chunk] + pos, a_handle.length };
+	}
+
+	// maps an externally owned, contiguous region onto the leading chunks of an empty arena
+	// offsets into the region are valid handle offsets, and the region must outlive the arena
+	void adopt(std::span<const char> a_region)
+	{
+		assert(_chunk == 0 && !_head);
+		const auto count = (a_region.size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+		if (count >= _chunks.size()) {
+			stl::report_and_fail("string arena exhausted"sv);
+		}
+
+		for (std::size_t i = 0; i < count; ++i) {
+			_chunks[i] = a_region.data() + i * CHUNK_SIZE;
+		}
+		_chunk = static_cast<size_type>(count);
+		_used += a_region.size();
+	}
+
+	// bytes reserved from the allocator and bytes holding strings, for diagnostics
+	[[nodiscard]] std::size_t capacity() const noexcept { return _reserved; }
+	[[nodiscard]] std::size_t size() const noexcept { return _used; }
+
+	// only valid for handles returned by push_back_folded
+	// the copy is addressed from the string itself, since an oversized string's copy can run past the end of its chunk
+	[[nodiscard]] std::string_view view_folded(handle_type a_handle) const noexcept
+	{
+		return { view(a_handle).data() + a_handle.length, a_handle.length };
+	}
+
+	[[nodiscard]] handle_type push_back(std::string_view a_string)
+	{
+		const auto handle = reserve(a_string.length(), 1);
+		std::copy(a_string.begin(), a_string.end(), _head + (handle.offset & (CHUNK_SIZE - 1)));
+		return handle;
+	}
+
+	// stores a case folded shadow copy directly after the string, for searches which can't afford to fold on the fly
+	[[nodiscard]] handle_type push_back_folded(std::string_view a_string)
+	{
+		const auto handle = reserve(a_string.length(), 2);
+		const auto dst = _head + (handle.offset & (CHUNK_SIZE - 1));
+		std::copy(a_string.begin(), a_string.end(), dst);
+		std::transform(a_string.begin(), a_string.end(), dst + a_string.length(), stl::tolower);
+		return handle;
+	}
+
+private:
+	[[nodiscard]] handle_type reserve(std::size_t a_length, size_type a_copies)
+	{
+		const auto length = static_cast<size_type>(a_length);
+		const auto size = length * a_copies;
+		if (!_head || CHUNK_SIZE - _pos < size) {
+			grow(std::max(size, CHUNK_SIZE));
+		}
+
+		const handle_type handle{ (_chunk << CHUNK_SHIFT) | _pos, length };
+		_pos = std::min(_pos + size, CHUNK_SIZE);  // oversized strings fill their chunk
+		_used += size;
+		return handle;
+	}
+
+	void grow(size_type a_size)
+	{
+		if (_head) {
+			++_chunk;
+		}
+
+		if (_chunk >= _chunks.size()) {
+			stl::report_and_fail("string arena exhausted"sv);
+		}
+
+		_head = _storage.emplace_back(std::make_unique_for_overwrite<char[]>(a_size)).get();
+		_chunks[_chunk] = _head;
+		_reserved += a_size;
+		_pos = 0;
+	}
+
+	std::array<const char*, MAX_CHUNKS> _chunks{};
+	std::vector<std::unique_ptr<char[]>> _storage;
+	char* _head{ nullptr };
+	size_type _chunk{ 0 };
+	size_type _pos{ 0 };
+	std::size_t _reserved{ 0 };
+	std::size_t _used{ 0 };
+};
@@ -0,0 +1,139 @@
+#pragma once
+
+// ascii case insensitive substring search
+// candidate positions are found by comparing the first and last characters of the needle against a whole
+// block of the haystack at once, and only those positions are verified character by character
+class SubstringSearcher
+{
+public:
+	SubstringSearcher() = default;
+
+	explicit SubstringSearcher(std::string_view a_needle) :
+		_needle(a_needle)
+	{
+		for (auto& ch : _needle) {
+			ch = stl::tolower(ch);
+		}
+	}
+
+	SubstringSearcher(const SubstringSearcher&) = default;
+	SubstringSearcher(SubstringSearcher&&) = default;
+
+	~SubstringSearcher() = default;
+
+	SubstringSearcher& operator=(const SubstringSearcher&) = default;
+	SubstringSearcher& operator=(SubstringSearcher&&) = default;
+
+	[[nodiscard]] std::string_view needle() const noexcept { return _needle; }
+
+	[[nodiscard]] bool operator()(std::string_view a_haystack) const noexcept { return search<true>(a_haystack); }
+
+	// the haystack must already be case folded
+	[[nodiscard]] bool folded(std::string_view a_haystack) const noexcept { return search<false>(a_haystack); }
+
+private:
+	template <bool FOLD>
+	[[nodiscard]] static char fold(char a_ch) noexcept
+	{
+		if constexpr (FOLD) {
+			return stl::tolower(a_ch);
+		} else {
+			return a_ch;
+		}
+	}
+
+	// compares a haystack against a folded needle
+	template <bool FOLD>
+	[[nodiscard]] static bool equal(const char* a_haystack, const char* a_needle, std::size_t a_length) noexcept
+	{
+		if constexpr (FOLD) {
+			for (std::size_t i = 0; i < a_length; ++i) {
+				if (stl::tolower(a_haystack[i]) != a_needle[i]) {
+					return false;
+				}
+			}
+			return true;
+		} else {
+			return std::memcmp(a_haystack, a_needle, a_length) == 0;
+		}
+	}
+
+	template <bool FOLD>
+	[[nodiscard]] bool search(std::string_view a_haystack) const noexcept
+	{
+		const auto n = _needle.length();
+		if (n == 0) {
+			return true;
+		} else if (a_haystack.length() < n) {
+			return false;
+		}
+
+		std::size_t i = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+		i = search_sse2<FOLD>(a_haystack);
+#endif
+		if (i == std::string_view::npos) {
+			return true;
+		}
+
+		for (; i + n <= a_haystack.length(); ++i) {
+			if (fold<FOLD>(a_haystack[i]) == _needle.front() &&
+				equal<FOLD>(a_haystack.data() + i + 1, _needle.data() + 1, n - 1)) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	// sse2 is part of x64 itself, so unlike wider extensions it needs no runtime check
+#if defined(__SSE2__) || defined(_M_X64)
+	// 'A'..'Z' are shifted down to the bottom of the signed range, where a single compare isolates them
+	[[nodiscard]] static __m128i tolower(__m128i a_src) noexcept
+	{
+		const auto shifted = _mm_add_epi8(a_src, _mm_set1_epi8(static_cast<char>(0x80 - 'A')));
+		const auto upper = _mm_cmplt_epi8(shifted, _mm_set1_epi8(static_cast<char>(0x80 + 26)));
+		return _mm_or_si128(a_src, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+	}
+
+	template <bool FOLD>
+	[[nodiscard]] static __m128i load(const char* a_src) noexcept
+	{
+		const auto result = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a_src));
+		if constexpr (FOLD) {
+			return tolower(result);
+		} else {
+			return result;
+		}
+	}
+
+	// returns npos on a match, otherwise the position the scalar search should resume from
+	template <bool FOLD>
+	[[nodiscard]] std::size_t search_sse2(std::string_view a_haystack) const noexcept
+	{
+		constexpr auto width = sizeof(__m128i);
+
+		const auto n = _needle.length();
+		const auto first = _mm_set1_epi8(_needle.front());
+		const auto last = _mm_set1_epi8(_needle.back());
+		const auto middle = n > 2 ? n - 2 : 0;
+
+		std::size_t i = 0;
+		for (; i + n - 1 + width <= a_haystack.length(); i += width) {
+			const auto lhs = load<FOLD>(a_haystack.data() + i);
+			const auto rhs = load<FOLD>(a_haystack.data() + i + n - 1);
+			const auto mask = _mm_and_si128(_mm_cmpeq_epi8(lhs, first), _mm_cmpeq_epi8(rhs, last));
+			for (auto bits = static_cast<std::uint32_t>(_mm_movemask_epi8(mask)); bits != 0; bits &= bits - 1) {
+				const auto pos = i + static_cast<std::size_t>(std::countr_zero(bits));
+				if (equal<FOLD>(a_haystack.data() + pos + 1, _needle.data() + 1, middle)) {
+					return std::string_view::npos;
+				}
+			}
+		}
+
+		return i;
+	}
+#endif
+
+	std::string _needle;
+};
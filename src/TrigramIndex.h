@@ -0,0 +1,124 @@
+#pragma once
+
+// an inverted index from case folded trigrams to the ids whose text contains them
+// every occurrence of a needle contains all of the needle's trigrams, so intersecting their posting lists
+// yields a superset of the matches which can then be verified by a real substring search
+class TrigramIndex
+{
+public:
+	using id_type = std::uint32_t;
+
+	static constexpr std::size_t GRAM_SIZE = 3;
+
+	TrigramIndex() = default;
+	TrigramIndex(const TrigramIndex&) = default;
+	TrigramIndex(TrigramIndex&&) = default;
+
+	~TrigramIndex() = default;
+
+	TrigramIndex& operator=(const TrigramIndex&) = default;
+	TrigramIndex& operator=(TrigramIndex&&) = default;
+
+	void insert(id_type a_id, std::string_view a_text)
+	{
+		for (std::size_t i = 0; i + GRAM_SIZE <= a_text.length(); ++i) {
+			_pending.push_back((std::uint64_t{ gram(a_text.data() + i) } << 32) | a_id);
+		}
+	}
+
+	// folds all pending inserts into the posting lists
+	void build()
+	{
+		if (_pending.empty()) {
+			return;
+		}
+
+		for (std::size_t i = 0; i < _keys.size(); ++i) {
+			for (auto j = _offsets[i]; j < _offsets[i + 1]; ++j) {
+				_pending.push_back((std::uint64_t{ _keys[i] } << 32) | _postings[j]);
+			}
+		}
+
+		std::sort(std::execution::par_unseq, _pending.begin(), _pending.end());
+		_pending.erase(std::unique(_pending.begin(), _pending.end()), _pending.end());
+
+		_keys.clear();
+		_offsets.clear();
+		_postings.clear();
+		_postings.reserve(_pending.size());
+		for (const auto elem : _pending) {
+			const auto key = static_cast<std::uint32_t>(elem >> 32);
+			if (_keys.empty() || _keys.back() != key) {
+				_keys.push_back(key);
+				_offsets.push_back(static_cast<std::uint32_t>(_postings.size()));
+			}
+			_postings.push_back(static_cast<id_type>(elem));
+		}
+		_offsets.push_back(static_cast<std::uint32_t>(_postings.size()));
+
+		decltype(_pending)().swap(_pending);
+	}
+
+	// returns the sorted ids which may contain the needle, or nothing if the needle is too short to be pruned
+	[[nodiscard]] std::optional<std::vector<id_type>> find(std::string_view a_needle) const
+	{
+		if (a_needle.length() < GRAM_SIZE) {
+			return std::nullopt;
+		}
+
+		std::vector<std::uint32_t> grams;
+		for (std::size_t i = 0; i + GRAM_SIZE <= a_needle.length(); ++i) {
+			grams.push_back(gram(a_needle.data() + i));
+		}
+		std::sort(grams.begin(), grams.end());
+		grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+
+		std::vector<std::span<const id_type>> lists;
+		for (const auto key : grams) {
+			const auto it = std::lower_bound(_keys.begin(), _keys.end(), key);
+			if (it == _keys.end() || *it != key) {
+				return std::vector<id_type>{};
+			}
+
+			const auto pos = static_cast<std::size_t>(it - _keys.begin());
+			lists.emplace_back(_postings.data() + _offsets[pos], _offsets[pos + 1] - _offsets[pos]);
+		}
+
+		std::sort(
+			lists.begin(),
+			lists.end(),
+			[](auto&& a_lhs, auto&& a_rhs) noexcept {
+				return a_lhs.size() < a_rhs.size();
+			});
+
+		std::vector<id_type> result{ lists.front().begin(), lists.front().end() };
+		std::vector<id_type> scratch;
+		for (std::size_t i = 1; i < lists.size() && !result.empty(); ++i) {
+			scratch.clear();
+			std::set_intersection(
+				result.begin(),
+				result.end(),
+				lists[i].begin(),
+				lists[i].end(),
+				std::back_inserter(scratch));
+			result.swap(scratch);
+		}
+
+		return result;
+	}
+
+private:
+	[[nodiscard]] static std::uint32_t gram(const char* a_str) noexcept
+	{
+		std::uint32_t result = 0;
+		for (std::size_t i = 0; i < GRAM_SIZE; ++i) {
+			result = (result << 8) | static_cast<unsigned char>(stl::tolower(a_str[i]));
+		}
+		return result;
+	}
+
+	std::vector<std::uint32_t> _keys;
+	std::vector<std::uint32_t> _offsets;
+	std::vector<id_type> _postings;
+	std::vector<std::uint64_t> _pending;
+};
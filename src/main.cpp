@@ -1,5 +1,30 @@
 #include "CC/CC.h"
+#include "CreatedForms.h"
+#include "DisplayNameCache.h"
 #include "EditorIDCache.h"
+#include "FunctionIndex.h"
+#include "Metrics.h"
+#include "Settings.h"
+
+void MessageHandler(F4SE::MessagingInterface::Message* a_message)
+{
+	switch (a_message->type) {
+	case F4SE::MessagingInterface::kPostPostLoad:
+		FunctionIndex::get().build();  // pick up the functions renamed by every plugin, including this one
+		break;
+	case F4SE::MessagingInterface::kGameDataReady:
+		if (static_cast<bool>(a_message->data)) {
+			EditorIDCache::get().sync();
+		}
+		break;
+	case F4SE::MessagingInterface::kPostLoadGame:
+	case F4SE::MessagingInterface::kNewGame:
+		DisplayNameCache::get().invalidate();
+		break;
+	default:
+		break;
+	}
+}
 
 extern "C" DLLEXPORT bool F4SEAPI F4SEPlugin_Query(const F4SE::QueryInterface* a_f4se, F4SE::PluginInfo* a_info)
 {
@@ -53,8 +78,18 @@ extern "C" DLLEXPORT bool F4SEAPI F4SEPlugin_Load(const F4SE::LoadInterface* a_f
 
 	F4SE::Init(a_f4se);
 
+	Settings::get().load();
+
 	CC::Install();
-	EditorIDCache::get().install();
+	EditorIDCache::get().install(Settings::get().foldCase());
+	CreatedForms::get().install();
+	Metrics::get().start(std::chrono::minutes(5));
+
+	const auto messaging = F4SE::GetMessagingInterface();
+	if (!messaging || !messaging->RegisterListener(MessageHandler)) {
+		logger::critical("failed to register messaging listener"sv);
+		return false;
+	}
 
 	return true;
 }